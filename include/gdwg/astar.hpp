@@ -0,0 +1,270 @@
+#ifndef GDWG_ASTAR_HPP
+#define GDWG_ASTAR_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/heap.hpp>
+#include <gdwg/shortest_paths.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A* search: Dijkstra's algorithm steered towards the destination by a lower bound on each
+// node's remaining distance, either from gdwg::landmarks or from the caller.
+namespace gdwg {
+	namespace detail {
+		// Distances from every node to target, by Dijkstra's algorithm over in-edges.
+		template<typename N, typename E>
+		auto distances_to(frozen_graph<N, E> const& g, std::size_t target) -> std::vector<E> {
+			auto distance = std::vector<E>(g.size(), unreachable<E>);
+			auto queue = binary_heap::heap<E>(g.size());
+			distance[target] = E{};
+			queue.push(target, E{});
+			while (!queue.empty()) {
+				auto const [to, d] = queue.pop();
+				auto const neighbours = g.in_neighbours(to);
+				auto const edges = g.in_edges(to);
+				for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+					auto const from = neighbours[i];
+					auto const candidate = saturating_add(d, g.weight(edges[i]));
+					if (candidate < distance[from]) {
+						distance[from] = candidate;
+						queue.push(from, candidate);
+					}
+				}
+			}
+			return distance;
+		}
+
+		// A* from source to target. estimate(rank) must never exceed the distance from rank to
+		// target; if it is also consistent, no node is settled twice.
+		template<typename Heap, typename N, typename E, typename F>
+		auto astar(frozen_graph<N, E> const& g, std::size_t source, std::size_t target, F&& estimate)
+		   -> shortest_paths<E> {
+			auto result = shortest_paths<E>{std::vector<E>(g.size(), unreachable<E>),
+			                                std::vector<std::size_t>(g.size(), no_rank)};
+			auto queue = typename Heap::template heap<E>(g.size());
+			result.distance[source] = E{};
+			queue.push(source, estimate(source));
+
+			while (!queue.empty()) {
+				auto const from = queue.pop().first;
+				if (from == target) {
+					break;
+				}
+
+				auto const distance = result.distance[from];
+				auto const neighbours = g.out_neighbours(from);
+				auto const weights = g.out_weights(from);
+				for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+					if (weights[i] < E{}) {
+						throw std::runtime_error("Cannot call gdwg::astar on a graph with negative edge "
+						                         "weights");
+					}
+					auto const to = neighbours[i];
+					auto const candidate = saturating_add(distance, weights[i]);
+					if (candidate < result.distance[to]) {
+						result.distance[to] = candidate;
+						result.predecessor[to] = from;
+						queue.push(to, saturating_add(candidate, estimate(to)));
+					}
+				}
+			}
+			return result;
+		}
+	} // namespace detail
+
+	// Landmarks for A* (the ALT method of Goldberg and Harrelson): a few nodes, with every node's
+	// distance to and from each of them. By the triangle inequality, d(v, t) is at least
+	// d(L, t) - d(L, v) and d(v, L) - d(t, L) for every landmark L.
+	//
+	// Landmarks are picked farthest first: each is the node furthest from those already picked,
+	// which spreads them around the edge of the graph where their bounds are tightest. Two
+	// searches per landmark, the reverse ones in parallel across pool, fill a table of 2k
+	// distances per node, laid out so one node's distances sit together.
+	//
+	// The bounds hold for any graph with the same nodes whose edges are no lighter than when the
+	// landmarks were built, so a graph whose weights only rise, e.g. with traffic, can keep its
+	// landmarks and just be frozen again; build them from the lightest weights expected.
+	template<typename E>
+	requires std::is_arithmetic_v<E>
+	class landmarks {
+	public:
+		template<typename N>
+		landmarks(frozen_graph<N, E> const& g,
+		          std::size_t count,
+		          thread_pool& pool = default_thread_pool())
+		: size_(g.size()) {
+			constexpr auto negative_weight_error = "Cannot call gdwg::landmarks on a graph with "
+			                                       "negative edge weights";
+			if (g.edge_count() > 0 && g.min_weight() < E{}) {
+				throw std::runtime_error(negative_weight_error);
+			}
+			count = std::min(count, size_);
+			if (count == 0) {
+				return;
+			}
+			auto const forward = [&g, negative_weight_error](std::size_t source) {
+				return detail::dijkstra<binary_heap>(g, source, no_rank, negative_weight_error)
+				   .distance;
+			};
+
+			// unreachable nodes count as furthest of all, so every component gets a landmark
+			auto closest = forward(0);
+			auto from = std::vector<std::vector<E>>{};
+			while (ranks_.size() < count) {
+				auto const next = static_cast<std::size_t>(
+				   std::max_element(closest.begin(), closest.end()) - closest.begin());
+				ranks_.push_back(next);
+				from.push_back(forward(next));
+				std::transform(closest.begin(),
+				               closest.end(),
+				               from.back().begin(),
+				               closest.begin(),
+				               [](E lhs, E rhs) { return std::min(lhs, rhs); });
+			}
+			auto to = std::vector<std::vector<E>>(count);
+			pool.for_each_index(count, [&](std::size_t landmark, std::size_t) {
+				to[landmark] = detail::distances_to(g, ranks_[landmark]);
+			});
+
+			from_landmark_.resize(size_ * count);
+			to_landmark_.resize(size_ * count);
+			for (auto rank = std::size_t{0}; rank < size_; ++rank) {
+				for (auto landmark = std::size_t{0}; landmark < count; ++landmark) {
+					from_landmark_[rank * count + landmark] = from[landmark][rank];
+					to_landmark_[rank * count + landmark] = to[landmark][rank];
+				}
+			}
+		}
+
+		template<typename N, typename Storage>
+		landmarks(graph<N, E, Storage> const& g,
+		          std::size_t count,
+		          thread_pool& pool = default_thread_pool())
+		: landmarks(frozen_graph<N, E>(g), count, pool) {}
+
+		// The number of nodes in the graph the landmarks were built for.
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+		// The landmarks' ranks, in the order they were picked.
+		[[nodiscard]] auto ranks() const noexcept -> std::vector<std::size_t> const& {
+			return ranks_;
+		}
+
+		// A lower bound on the distance from the node of rank from to the node of rank to.
+		[[nodiscard]] auto lower_bound(std::size_t from, std::size_t to) const -> E {
+			constexpr auto none = unreachable<E>;
+			auto const count = ranks_.size();
+			auto bound = E{};
+			for (auto landmark = std::size_t{0}; landmark < count; ++landmark) {
+				auto const landmark_from = from_landmark_[from * count + landmark];
+				auto const landmark_to = from_landmark_[to * count + landmark];
+				if (landmark_from < landmark_to && landmark_to != none) {
+					bound = std::max(bound, static_cast<E>(landmark_to - landmark_from));
+				}
+				auto const from_landmark = to_landmark_[from * count + landmark];
+				auto const to_landmark = to_landmark_[to * count + landmark];
+				if (to_landmark < from_landmark && from_landmark != none) {
+					bound = std::max(bound, static_cast<E>(from_landmark - to_landmark));
+				}
+			}
+			return bound;
+		}
+
+	private:
+		std::size_t size_;
+		std::vector<std::size_t> ranks_;
+		// rank * ranks_.size() + landmark -> distance from, or to, that landmark
+		std::vector<E> from_landmark_;
+		std::vector<E> to_landmark_;
+	};
+
+	// Like shortest_path, but guided towards dst by the landmarks' bounds, which must have been
+	// built for a graph with the same nodes. Only dst and the nodes settled before it are
+	// guaranteed to hold their final distance and predecessor.
+	template<typename Heap = binary_heap,
+	         typename N,
+	         typename E,
+	         node_key<N> Src,
+	         node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto astar(frozen_graph<N, E> const& g,
+	           Src const& src,
+	           Dst const& dst,
+	           landmarks<E> const& bounds) -> shortest_paths<E> {
+		auto const source = g.rank(src);
+		auto const target = g.rank(dst);
+		if (source == no_rank || target == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::astar if src or dst node don't exist in the "
+			                         "graph");
+		}
+		if (bounds.size() != g.size()) {
+			throw std::runtime_error("Cannot call gdwg::astar with landmarks built for a different "
+			                         "graph");
+		}
+		return detail::astar<Heap>(g, source, target, [&](std::size_t rank) {
+			return bounds.lower_bound(rank, target);
+		});
+	}
+
+	// Like shortest_path, but guided towards dst by heuristic(node), which must never exceed the
+	// distance from node to dst. If it is also consistent (the estimate drops by no more than an
+	// edge's weight along that edge), every node is settled at most once.
+	template<typename Heap = binary_heap,
+	         typename N,
+	         typename E,
+	         node_key<N> Src,
+	         node_key<N> Dst,
+	         std::invocable<N const&> H>
+	requires std::is_arithmetic_v<E>
+	auto astar(frozen_graph<N, E> const& g, Src const& src, Dst const& dst, H heuristic)
+	   -> shortest_paths<E> {
+		auto const source = g.rank(src);
+		auto const target = g.rank(dst);
+		if (source == no_rank || target == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::astar if src or dst node don't exist in the "
+			                         "graph");
+		}
+		return detail::astar<Heap>(g, source, target, [&](std::size_t rank) {
+			return static_cast<E>(heuristic(g.node(rank)));
+		});
+	}
+
+	template<typename Heap = binary_heap,
+	         typename N,
+	         typename E,
+	         typename Storage,
+	         node_key<N> Src,
+	         node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto astar(graph<N, E, Storage> const& g,
+	           Src const& src,
+	           Dst const& dst,
+	           landmarks<E> const& bounds) -> shortest_paths<E> {
+		return astar<Heap>(frozen_graph<N, E>(g), src, dst, bounds);
+	}
+
+	template<typename Heap = binary_heap,
+	         typename N,
+	         typename E,
+	         typename Storage,
+	         node_key<N> Src,
+	         node_key<N> Dst,
+	         std::invocable<N const&> H>
+	requires std::is_arithmetic_v<E>
+	auto astar(graph<N, E, Storage> const& g, Src const& src, Dst const& dst, H heuristic)
+	   -> shortest_paths<E> {
+		return astar<Heap>(frozen_graph<N, E>(g), src, dst, std::move(heuristic));
+	}
+} // namespace gdwg
+
+#endif // GDWG_ASTAR_HPP
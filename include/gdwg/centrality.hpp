@@ -0,0 +1,364 @@
+#ifndef GDWG_CENTRALITY_HPP
+#define GDWG_CENTRALITY_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/heap.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Node centrality scores. Like the other algorithms they run on a gdwg::frozen_graph and return
+// one score per node rank, i.e. aligned with graph::nodes().
+namespace gdwg {
+	// How pagerank's random surfer picks among a node's out-edges.
+	enum class transition {
+		// Every out-edge is equally likely, whatever its weight.
+		uniform,
+		// Out-edges are taken in proportion to their weight. Every edge of a graph<N, void> weighs
+		// one, which makes this the same as uniform.
+		by_weight,
+	};
+
+	// PageRank by power iteration: the stationary distribution of a walk that follows an out-edge
+	// with probability damping and otherwise jumps to a node chosen uniformly at random. Nodes
+	// without out-edges (or whose out-edges all weigh zero) jump every time. Scores sum to one.
+	//
+	// The transition matrix is laid out once by destination, so each iteration is a pull-style
+	// sparse matrix-vector product over contiguous arrays, split across pool by node range. It
+	// stops once an iteration moves the scores by at most tolerance in total (L1 norm), or once
+	// rounding stops them from settling any further.
+	template<typename N, typename E>
+	requires std::is_void_v<E> || std::is_arithmetic_v<E>
+	auto pagerank(frozen_graph<N, E> const& g,
+	              double damping = 0.85,
+	              double tolerance = 1e-9,
+	              transition follow = transition::uniform,
+	              thread_pool& pool = default_thread_pool()) -> std::vector<double> {
+		if (!(damping >= 0.0 && damping < 1.0)) {
+			throw std::runtime_error("Cannot call gdwg::pagerank with a damping factor outside "
+			                         "[0, 1)");
+		}
+		auto const size = g.size();
+		if (size == 0) {
+			return {};
+		}
+
+		// out_total[u] is the weight a walk leaving u divides among its out-edges
+		auto out_total = std::vector<double>(size);
+		for (auto from = std::size_t{0}; from < size; ++from) {
+			if constexpr (!std::is_void_v<E>) {
+				if (follow == transition::by_weight) {
+					auto const first = g.first_out_edge(from);
+					for (auto edge = first; edge < first + g.out_degree(from); ++edge) {
+						if (g.weight(edge) < E{}) {
+							throw std::runtime_error("Cannot call gdwg::pagerank on a graph with "
+							                         "negative edge weights");
+						}
+						out_total[from] += static_cast<double>(g.weight(edge));
+					}
+					continue;
+				}
+			}
+			out_total[from] = static_cast<double>(g.out_degree(from));
+		}
+
+		// probability[offset[v] + i] is the chance of stepping along v's i-th in-edge
+		auto offset = std::vector<std::size_t>(size + 1);
+		auto probability = std::vector<double>(g.edge_count());
+		for (auto to = std::size_t{0}; to < size; ++to) {
+			offset[to + 1] = offset[to] + g.in_degree(to);
+			auto const sources = g.in_neighbours(to);
+			auto const edges = g.in_edges(to);
+			for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+				auto weight = 1.0;
+				if constexpr (!std::is_void_v<E>) {
+					if (follow == transition::by_weight) {
+						weight = static_cast<double>(g.weight(edges[i]));
+					}
+				}
+				probability[offset[to] + i] = weight == 0.0 ? 0.0 : weight / out_total[sources[i]];
+			}
+		}
+		auto dangling = std::vector<std::size_t>{};
+		for (auto from = std::size_t{0}; from < size; ++from) {
+			if (out_total[from] == 0.0) {
+				dangling.push_back(from);
+			}
+		}
+
+		auto const n = static_cast<double>(size);
+		auto score = std::vector<double>(size, 1.0 / n);
+		auto next = std::vector<double>(size);
+		auto change = std::vector<double>(pool.size());
+		for (auto previous = unreachable<double>;;) {
+			auto stranded = 0.0;
+			for (auto const from : dangling) {
+				stranded += score[from];
+			}
+			auto const base = (1.0 - damping) / n + damping * stranded / n;
+
+			pool.for_each_chunk(
+			   size,
+			   pool.default_grain(size),
+			   [&](std::size_t first, std::size_t last, std::size_t thread) {
+				   auto moved = 0.0;
+				   for (auto to = first; to < last; ++to) {
+					   auto const sources = g.in_neighbours(to);
+					   auto const* const p = probability.data() + offset[to];
+					   auto sum = 0.0;
+					   for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+						   sum += p[i] * score[sources[i]];
+					   }
+					   next[to] = base + damping * sum;
+					   moved += std::abs(next[to] - score[to]);
+				   }
+				   change[thread] += moved;
+			   });
+			score.swap(next);
+
+			auto total = 0.0;
+			for (auto& moved : change) {
+				total += moved;
+				moved = 0.0;
+			}
+			// each step shrinks the change by at least damping, short of rounding error
+			if (total <= tolerance || total >= previous) {
+				break;
+			}
+			previous = total;
+		}
+		return score;
+	}
+
+	template<typename N, typename E, typename Storage>
+	requires std::is_void_v<E> || std::is_arithmetic_v<E>
+	auto pagerank(graph<N, E, Storage> const& g,
+	              double damping = 0.85,
+	              double tolerance = 1e-9,
+	              transition follow = transition::uniform,
+	              thread_pool& pool = default_thread_pool()) -> std::vector<double> {
+		return pagerank(frozen_graph<N, E>(g), damping, tolerance, follow, pool);
+	}
+
+	struct betweenness_options {
+		// The number of source nodes to sample, uniformly at random without replacement. The
+		// scores from those sources are scaled up to estimate the exact ones. Zero, or at least
+		// the number of nodes, takes every node as a source and gives exact scores.
+		std::size_t samples = 0;
+		// Picks the sample; the same seed on the same graph samples the same sources.
+		std::uint64_t seed = 0;
+		// Divides every score by (n - 1)(n - 2), the number of ordered pairs of other nodes.
+		bool normalised = false;
+	};
+
+	namespace detail {
+		// One thread's share of Brandes' algorithm: the dependencies of every source it is given,
+		// summed into its own centrality array, with search arrays reused from one source to the
+		// next and reset only where the search reached.
+		template<typename N, typename E>
+		class brandes {
+		public:
+			// Hops for a graph<N, void>, and path weights otherwise.
+			using distance_type = std::conditional_t<std::is_void_v<E>, std::size_t, E>;
+
+			explicit brandes(frozen_graph<N, E> const& g)
+			: g_(&g) {}
+
+			auto add_source(std::size_t source) -> void {
+				if (centrality_.empty()) {
+					auto const size = g_->size();
+					centrality_.resize(size);
+					distance_.resize(size, unreachable<distance_type>);
+					paths_.resize(size);
+					dependency_.resize(size);
+					if constexpr (!std::is_void_v<E>) {
+						queue_ = binary_heap::heap<distance_type>(size);
+					}
+				}
+				search(source);
+				accumulate(source);
+			}
+
+			[[nodiscard]] auto centrality() const -> std::vector<double> const& {
+				return centrality_;
+			}
+
+		private:
+			frozen_graph<N, E> const* g_;
+			std::vector<double> centrality_;
+			std::vector<distance_type> distance_;
+			// the number of shortest paths from source, as a double since it grows exponentially
+			std::vector<double> paths_;
+			std::vector<double> dependency_;
+			// the nodes reached, in order of distance from source
+			std::vector<std::size_t> order_;
+			binary_heap::heap<distance_type> queue_{0};
+
+			// Counts the shortest paths from source to every node, settling nodes in order.
+			auto search(std::size_t source) -> void {
+				distance_[source] = distance_type{};
+				paths_[source] = 1.0;
+				if constexpr (std::is_void_v<E>) {
+					order_.push_back(source);
+					for (auto i = std::size_t{0}; i < order_.size(); ++i) {
+						auto const from = order_[i];
+						auto const next = distance_[from] + 1;
+						for (auto const to : g_->out_neighbours(from)) {
+							if (distance_[to] == unreachable<std::size_t>) {
+								distance_[to] = next;
+								order_.push_back(to);
+							}
+							if (distance_[to] == next) {
+								paths_[to] += paths_[from];
+							}
+						}
+					}
+				}
+				else {
+					queue_.push(source, E{});
+					while (!queue_.empty()) {
+						auto const from = queue_.pop().first;
+						order_.push_back(from);
+						auto const neighbours = g_->out_neighbours(from);
+						auto const weights = g_->out_weights(from);
+						for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+							auto const to = neighbours[i];
+							if (to == from) {
+								continue;
+							}
+							auto const candidate = saturating_add(distance_[from], weights[i]);
+							if (candidate == unreachable<E>) {
+								continue;
+							}
+							if (candidate < distance_[to]) {
+								distance_[to] = candidate;
+								paths_[to] = paths_[from];
+								queue_.push(to, candidate);
+							}
+							else if (candidate == distance_[to]) {
+								paths_[to] += paths_[from];
+							}
+						}
+					}
+				}
+			}
+
+			// Adds each reached node's dependency on source to its centrality, furthest first, so
+			// that a node's dependency is complete before it is passed back to its predecessors.
+			auto accumulate(std::size_t source) -> void {
+				for (auto i = order_.size(); i-- > 0;) {
+					auto const to = order_[i];
+					auto const sources = g_->in_neighbours(to);
+					auto const edges = g_->in_edges(to);
+					auto const share = (1.0 + dependency_[to]) / paths_[to];
+					for (auto j = std::size_t{0}; j < sources.size(); ++j) {
+						auto const from = sources[j];
+						if (from == to || distance_[from] == unreachable<distance_type>) {
+							continue;
+						}
+						auto step = distance_type{1};
+						if constexpr (!std::is_void_v<E>) {
+							step = g_->weight(edges[j]);
+						}
+						if (saturating_add(distance_[from], step) == distance_[to]) {
+							dependency_[from] += paths_[from] * share;
+						}
+					}
+					if (to != source) {
+						centrality_[to] += dependency_[to];
+					}
+				}
+				for (auto const rank : order_) {
+					distance_[rank] = unreachable<distance_type>;
+					paths_[rank] = 0.0;
+					dependency_[rank] = 0.0;
+				}
+				order_.clear();
+			}
+		};
+	} // namespace detail
+
+	// Betweenness centrality by Brandes' algorithm: for each node v, the sum over ordered pairs
+	// of other nodes s and t of the fraction of shortest paths from s to t that pass through v.
+	// Paths are shortest by weight, or by number of edges in a graph<N, void>. With edges weighing
+	// zero, nodes tied at the same distance may be settled before all their paths are counted,
+	// so scores are only exact when every edge weighs more than zero.
+	//
+	// Sources are split across pool, each thread summing dependencies into its own array, with
+	// the arrays added up once at the end. Each source costs one breadth-first search on a
+	// graph<N, void> or one Dijkstra search otherwise, so sampling k sources instead of all n
+	// cuts the work by a factor of n / k.
+	template<typename N, typename E>
+	requires std::is_void_v<E> || std::is_arithmetic_v<E>
+	auto betweenness_centrality(frozen_graph<N, E> const& g,
+	                            betweenness_options const& options = {},
+	                            thread_pool& pool = default_thread_pool()) -> std::vector<double> {
+		if constexpr (!std::is_void_v<E>) {
+			if (g.edge_count() > 0 && g.min_weight() < E{}) {
+				throw std::runtime_error("Cannot call gdwg::betweenness_centrality on a graph with "
+				                         "negative edge weights");
+			}
+		}
+		auto const size = g.size();
+		auto sources = std::vector<std::size_t>(size);
+		std::iota(sources.begin(), sources.end(), std::size_t{0});
+		auto scale = 1.0;
+		if (options.samples > 0 && options.samples < size) {
+			auto sample = std::vector<std::size_t>{};
+			sample.reserve(options.samples);
+			auto engine = std::mt19937_64(options.seed);
+			std::sample(sources.begin(), sources.end(), std::back_inserter(sample), options.samples,
+			            engine);
+			sources.swap(sample);
+			scale = static_cast<double>(size) / static_cast<double>(options.samples);
+		}
+		if (options.normalised && size > 2) {
+			scale /= static_cast<double>(size - 1) * static_cast<double>(size - 2);
+		}
+
+		auto workers = std::vector<detail::brandes<N, E>>(pool.size(), detail::brandes<N, E>(g));
+		pool.for_each_index(sources.size(), [&](std::size_t i, std::size_t thread) {
+			workers[thread].add_source(sources[i]);
+		});
+
+		auto result = std::vector<double>(size);
+		pool.for_each_chunk(
+		   size,
+		   pool.default_grain(size),
+		   [&](std::size_t first, std::size_t last, std::size_t) {
+			   for (auto const& worker : workers) {
+				   auto const& partial = worker.centrality();
+				   if (partial.empty()) {
+					   continue;
+				   }
+				   for (auto rank = first; rank < last; ++rank) {
+					   result[rank] += partial[rank];
+				   }
+			   }
+			   for (auto rank = first; rank < last; ++rank) {
+				   result[rank] *= scale;
+			   }
+		   });
+		return result;
+	}
+
+	template<typename N, typename E, typename Storage>
+	requires std::is_void_v<E> || std::is_arithmetic_v<E>
+	auto betweenness_centrality(graph<N, E, Storage> const& g,
+	                            betweenness_options const& options = {},
+	                            thread_pool& pool = default_thread_pool()) -> std::vector<double> {
+		return betweenness_centrality(frozen_graph<N, E>(g), options, pool);
+	}
+} // namespace gdwg
+
+#endif // GDWG_CENTRALITY_HPP
@@ -0,0 +1,191 @@
+#ifndef GDWG_COMPONENTS_HPP
+#define GDWG_COMPONENTS_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Connected components. Each algorithm returns one component id per node rank, i.e. aligned
+// with graph::nodes(), with ids numbered from zero.
+namespace gdwg {
+	namespace detail {
+		// A union-find forest over node ranks that threads can share without locks. A root only
+		// ever links under a smaller root, so each set's root is its smallest rank.
+		class concurrent_disjoint_sets {
+		public:
+			explicit concurrent_disjoint_sets(std::size_t size)
+			: parent_(size) {
+				for (auto rank = std::size_t{0}; rank < size; ++rank) {
+					parent_[rank].store(rank, std::memory_order_relaxed);
+				}
+			}
+
+			// The root of rank's set, halving the path on the way up.
+			auto find(std::size_t rank) -> std::size_t {
+				for (;;) {
+					auto parent = parent_[rank].load(std::memory_order_relaxed);
+					auto const grandparent = parent_[parent].load(std::memory_order_relaxed);
+					if (parent == grandparent) {
+						return parent;
+					}
+					// losing this race only means another thread moved rank up first
+					parent_[rank].compare_exchange_weak(parent,
+					                                    grandparent,
+					                                    std::memory_order_relaxed);
+					rank = grandparent;
+				}
+			}
+
+			// Merges the sets of lhs and rhs, returning whether they were apart.
+			auto unite(std::size_t lhs, std::size_t rhs) -> bool {
+				for (;;) {
+					lhs = find(lhs);
+					rhs = find(rhs);
+					if (lhs == rhs) {
+						return false;
+					}
+					if (lhs < rhs) {
+						std::swap(lhs, rhs);
+					}
+					// only succeeds while lhs is still a root
+					auto expected = lhs;
+					if (parent_[lhs].compare_exchange_strong(expected,
+					                                         rhs,
+					                                         std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+			}
+
+		private:
+			std::vector<std::atomic<std::size_t>> parent_;
+		};
+	} // namespace detail
+
+	// Strongly connected components by Tarjan's algorithm. Ids follow a topological order of the
+	// components: an edge from a node in component a to one in component b means a <= b.
+	//
+	// The depth-first search keeps its own stack of (node, next out-edge) frames instead of
+	// recursing, so it handles paths of any length, and every stack is reserved up front at one
+	// entry per node, so the search itself never allocates.
+	template<typename N, typename E>
+	auto strongly_connected_components(frozen_graph<N, E> const& g) -> std::vector<std::size_t> {
+		struct frame {
+			std::size_t rank;
+			std::size_t next_edge;
+		};
+
+		auto const size = g.size();
+		// order[v] is when v was first visited, low[v] the earliest node v's subtree reaches
+		auto order = std::vector<std::size_t>(size, no_rank);
+		auto low = std::vector<std::size_t>(size);
+		auto component = std::vector<std::size_t>(size, no_rank);
+		auto calls = std::vector<frame>{};
+		auto open = std::vector<std::size_t>{};
+		calls.reserve(size);
+		open.reserve(size);
+		auto visited = std::size_t{0};
+		auto found = std::size_t{0};
+
+		auto const visit = [&](std::size_t rank) {
+			order[rank] = low[rank] = visited++;
+			open.push_back(rank);
+			calls.push_back(frame{rank, g.first_out_edge(rank)});
+		};
+
+		for (auto root = std::size_t{0}; root < size; ++root) {
+			if (order[root] != no_rank) {
+				continue;
+			}
+			visit(root);
+			while (!calls.empty()) {
+				auto& top = calls.back();
+				auto const from = top.rank;
+				if (top.next_edge < g.first_out_edge(from) + g.out_degree(from)) {
+					auto const to = g.target(top.next_edge++);
+					if (order[to] == no_rank) {
+						visit(to);
+					}
+					else if (component[to] == no_rank) {
+						// still open, so on the current path's stack
+						low[from] = std::min(low[from], order[to]);
+					}
+					continue;
+				}
+
+				calls.pop_back();
+				if (!calls.empty()) {
+					auto const parent = calls.back().rank;
+					low[parent] = std::min(low[parent], low[from]);
+				}
+				if (low[from] == order[from]) {
+					auto member = no_rank;
+					do {
+						member = open.back();
+						open.pop_back();
+						component[member] = found;
+					} while (member != from);
+					++found;
+				}
+			}
+		}
+
+		// Tarjan finishes components sinks first; flip that into a topological order
+		for (auto& id : component) {
+			id = found - 1 - id;
+		}
+		return component;
+	}
+
+	template<typename N, typename E, typename Storage>
+	auto strongly_connected_components(graph<N, E, Storage> const& g) -> std::vector<std::size_t> {
+		return strongly_connected_components(frozen_graph<N, E>(g));
+	}
+
+	// Weakly connected components, i.e. ignoring edge direction. Ids are numbered in order of
+	// each component's first node.
+	//
+	// Nodes' out-edges are split into chunks across pool, and every edge joins its endpoints'
+	// sets in a shared lock-free union-find.
+	template<typename N, typename E>
+	auto weakly_connected_components(frozen_graph<N, E> const& g,
+	                                 thread_pool& pool = default_thread_pool())
+	   -> std::vector<std::size_t> {
+		auto const size = g.size();
+		auto sets = detail::concurrent_disjoint_sets(size);
+		pool.for_each_chunk(size, pool.default_grain(size), [&](auto first, auto last, auto) {
+			for (auto from = first; from < last; ++from) {
+				for (auto const to : g.out_neighbours(from)) {
+					sets.unite(from, to);
+				}
+			}
+		});
+
+		// a root is the smallest rank in its set, so it is numbered before any other member
+		auto component = std::vector<std::size_t>(size);
+		pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+			component[rank] = sets.find(rank);
+		});
+		auto found = std::size_t{0};
+		for (auto rank = std::size_t{0}; rank < size; ++rank) {
+			component[rank] = component[rank] == rank ? found++ : component[component[rank]];
+		}
+		return component;
+	}
+
+	template<typename N, typename E, typename Storage>
+	auto weakly_connected_components(graph<N, E, Storage> const& g,
+	                                 thread_pool& pool = default_thread_pool())
+	   -> std::vector<std::size_t> {
+		return weakly_connected_components(frozen_graph<N, E>(g), pool);
+	}
+} // namespace gdwg
+
+#endif // GDWG_COMPONENTS_HPP
@@ -0,0 +1,435 @@
+#ifndef GDWG_CONTRACTION_HPP
+#define GDWG_CONTRACTION_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		template<typename W>
+		struct arc {
+			std::size_t node;
+			W weight;
+		};
+
+		// Contracts the nodes of a graph one at a time, adding a shortcut between each pair of
+		// its remaining neighbours unless a witness path that avoids it is no longer.
+		template<typename W>
+		class hierarchy_builder {
+		public:
+			template<typename N>
+			explicit hierarchy_builder(frozen_graph<N, W> const& g)
+			: out_(g.size())
+			, in_(g.size())
+			, contracted_neighbours_(g.size())
+			, depth_(g.size())
+			, distance_(g.size(), unreachable<W>) {
+				for (auto from = std::size_t{0}; from < g.size(); ++from) {
+					auto const neighbours = g.out_neighbours(from);
+					auto const weights = g.out_weights(from);
+					for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+						if (neighbours[i] != from) {
+							add(from, neighbours[i], weights[i]);
+						}
+					}
+				}
+			}
+
+			// How much contracting rank now would grow the graph, plus how many of its neighbours
+			// are already gone and how deep the hierarchy under it is, both of which spread
+			// contractions evenly and keep query searches short. Lower goes first.
+			auto priority(std::size_t rank) -> std::ptrdiff_t {
+				auto const removed = out_[rank].size() + in_[rank].size();
+				last_shortcuts_ = shortcuts(rank);
+				last_rank_ = rank;
+				return 2 * (static_cast<std::ptrdiff_t>(last_shortcuts_.size())
+				       - static_cast<std::ptrdiff_t>(removed))
+				       + static_cast<std::ptrdiff_t>(contracted_neighbours_[rank])
+				       + static_cast<std::ptrdiff_t>(depth_[rank]);
+			}
+
+			// Adds rank's shortcuts and detaches it, leaving its edges to the remaining nodes in
+			// out(rank) and in(rank).
+			auto contract(std::size_t rank) -> void {
+				// usually its priority was just worked out, shortcuts and all
+				if (last_rank_ != rank) {
+					last_shortcuts_ = shortcuts(rank);
+				}
+				for (auto const& [from, to, weight] : last_shortcuts_) {
+					add(from, to, weight);
+				}
+				last_rank_ = no_rank;
+				for (auto const& [to, weight] : out_[rank]) {
+					std::erase_if(in_[to], [rank](arc<W> const& a) { return a.node == rank; });
+					++contracted_neighbours_[to];
+					depth_[to] = std::max(depth_[to], depth_[rank] + 1);
+				}
+				for (auto const& [from, weight] : in_[rank]) {
+					std::erase_if(out_[from], [rank](arc<W> const& a) { return a.node == rank; });
+					++contracted_neighbours_[from];
+					depth_[from] = std::max(depth_[from], depth_[rank] + 1);
+				}
+			}
+
+			[[nodiscard]] auto out(std::size_t rank) const -> std::vector<arc<W>> const& {
+				return out_[rank];
+			}
+
+			[[nodiscard]] auto in(std::size_t rank) const -> std::vector<arc<W>> const& {
+				return in_[rank];
+			}
+
+		private:
+			struct shortcut {
+				std::size_t from;
+				std::size_t to;
+				W weight;
+			};
+
+			// Witness searches give up after settling this many nodes and add the shortcut anyway,
+			// which costs a little query time but never correctness.
+			static constexpr auto max_settled = std::size_t{500};
+
+			std::vector<std::vector<arc<W>>> out_;
+			std::vector<std::vector<arc<W>>> in_;
+			std::vector<std::size_t> contracted_neighbours_;
+			std::vector<std::size_t> depth_;
+			std::vector<W> distance_;
+			std::vector<std::size_t> touched_;
+			std::vector<std::pair<W, std::size_t>> queue_;
+			std::vector<shortcut> last_shortcuts_;
+			std::size_t last_rank_ = no_rank;
+
+			// Adds an edge, or lowers the weight of the one already there.
+			auto add(std::size_t from, std::size_t to, W weight) -> void {
+				auto& out = out_[from];
+				auto const existing = std::find_if(out.begin(), out.end(), [to](arc<W> const& a) {
+					return a.node == to;
+				});
+				if (existing == out.end()) {
+					out.push_back({to, weight});
+					in_[to].push_back({from, weight});
+				}
+				else if (weight < existing->weight) {
+					existing->weight = weight;
+					std::find_if(in_[to].begin(), in_[to].end(), [from](arc<W> const& a) {
+						return a.node == from;
+					})->weight = weight;
+				}
+			}
+
+			// The shortcuts contracting rank needs: one for each in-neighbour u and out-neighbour
+			// x whose path u -> rank -> x is shorter than any other found from u.
+			auto shortcuts(std::size_t rank) -> std::vector<shortcut> {
+				auto result = std::vector<shortcut>{};
+				if (out_[rank].empty()) {
+					return result;
+				}
+				auto longest = out_[rank].front().weight;
+				for (auto const& [to, weight] : out_[rank]) {
+					longest = std::max(longest, weight);
+				}
+				for (auto const& [from, first_leg] : in_[rank]) {
+					witness_search(from, rank, static_cast<W>(first_leg + longest));
+					for (auto const& [to, second_leg] : out_[rank]) {
+						auto const via = static_cast<W>(first_leg + second_leg);
+						if (to != from && via < distance_[to]) {
+							result.push_back({from, to, via});
+						}
+					}
+					for (auto const touched : touched_) {
+						distance_[touched] = unreachable<W>;
+					}
+					touched_.clear();
+				}
+				return result;
+			}
+
+			// Dijkstra from source through the remaining nodes other than skip, until everything
+			// within limit is settled.
+			auto witness_search(std::size_t source, std::size_t skip, W limit) -> void {
+				constexpr auto later = std::greater<>{};
+				queue_.clear();
+				distance_[source] = W{};
+				touched_.push_back(source);
+				queue_.emplace_back(W{}, source);
+				for (auto settled = std::size_t{0}; !queue_.empty() && settled < max_settled;) {
+					std::pop_heap(queue_.begin(), queue_.end(), later);
+					auto const [distance, from] = queue_.back();
+					queue_.pop_back();
+					if (limit < distance) {
+						break;
+					}
+					if (distance_[from] < distance) {
+						continue;
+					}
+					++settled;
+					for (auto const& [to, weight] : out_[from]) {
+						auto const candidate = static_cast<W>(distance + weight);
+						if (to != skip && candidate < distance_[to]) {
+							if (distance_[to] == unreachable<W>) {
+								touched_.push_back(to);
+							}
+							distance_[to] = candidate;
+							queue_.emplace_back(candidate, to);
+							std::push_heap(queue_.begin(), queue_.end(), later);
+						}
+					}
+				}
+			}
+		};
+	} // namespace detail
+
+	// A contraction hierarchy (Geisberger et al.) over a snapshot of a graph with non-negative
+	// weights, for answering many point-to-point distance queries on a graph that rarely changes.
+	//
+	// Building it contracts every node in turn, cheapest first by a lazily updated estimate of
+	// the shortcuts it needs, so that paths between the nodes left are kept by shortcuts; this
+	// can take minutes on large graphs. A query then searches forwards from src and backwards
+	// from dst, each only along edges towards nodes contracted later, and typically settles a
+	// few hundred nodes however large the graph is. Nodes are stored in contraction order, so
+	// the search stays close together in memory.
+	//
+	// Queries only read the hierarchy, and each borrows scratch space that no other query is
+	// using, so any number may run concurrently.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	class contraction_hierarchy {
+	public:
+		explicit contraction_hierarchy(frozen_graph<N, E> const& g)
+		: nodes_(g.nodes())
+		, level_(g.size()) {
+			if (g.edge_count() > 0 && g.min_weight() < E{}) {
+				throw std::runtime_error("Cannot call gdwg::contraction_hierarchy on a graph with "
+				                         "negative edge weights");
+			}
+
+			using entry = std::pair<std::ptrdiff_t, std::size_t>;
+			auto builder = detail::hierarchy_builder<E>(g);
+			auto queue = std::priority_queue<entry, std::vector<entry>, std::greater<>>{};
+			for (auto rank = std::size_t{0}; rank < g.size(); ++rank) {
+				queue.emplace(builder.priority(rank), rank);
+			}
+			auto by_level = std::vector<std::size_t>{};
+			by_level.reserve(g.size());
+			while (!queue.empty()) {
+				auto const rank = queue.top().second;
+				queue.pop();
+				// contracting its neighbours may have changed rank's priority since it was queued
+				auto const priority = builder.priority(rank);
+				if (!queue.empty() && queue.top().first < priority) {
+					queue.emplace(priority, rank);
+					continue;
+				}
+				builder.contract(rank);
+				level_[rank] = by_level.size();
+				by_level.push_back(rank);
+				up_.append(builder.out(rank));
+				down_.append(builder.in(rank));
+			}
+
+			// every edge leads to a node contracted later, whose level is only known now
+			for (auto& to : up_.target) {
+				to = level_[to];
+			}
+			for (auto& to : down_.target) {
+				to = level_[to];
+			}
+		}
+
+		template<typename Storage>
+		explicit contraction_hierarchy(graph<N, E, Storage> const& g)
+		: contraction_hierarchy(frozen_graph<N, E>(g)) {}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		// The number of edges in both searches' graphs, i.e. the original edges (less parallel
+		// edges and self-loops) plus the shortcuts.
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return up_.target.size() + down_.target.size();
+		}
+
+		// The length of a shortest path from src to dst, or unreachable<E> if there is none.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto distance(Src const& src, Dst const& dst) const -> E {
+			auto const from = rank(src);
+			auto const to = rank(dst);
+			if (from == no_rank || to == no_rank) {
+				throw std::runtime_error("Cannot call gdwg::contraction_hierarchy::distance if src or "
+				                         "dst node don't exist in the graph");
+			}
+
+			auto searches = scratch_.take();
+			auto& [forward, backward] = *searches;
+			forward.start(level_[from], size());
+			backward.start(level_[to], size());
+			auto best = unreachable<E>;
+			for (;;) {
+				auto const forward_open = forward.open(best);
+				auto const backward_open = backward.open(best);
+				if (!forward_open && !backward_open) {
+					break;
+				}
+				if (forward_open && (!backward_open || forward.next() <= backward.next())) {
+					forward.settle(up_, down_, backward, best);
+				}
+				else {
+					backward.settle(down_, up_, forward, best);
+				}
+			}
+			forward.finish();
+			backward.finish();
+			scratch_.give_back(std::move(searches));
+			return best;
+		}
+
+	private:
+		// Edges by level in compressed sparse row form, each towards a higher level.
+		struct upward_graph {
+			std::vector<std::size_t> first = {0};
+			std::vector<std::size_t> target;
+			std::vector<E> weight;
+
+			auto append(std::vector<detail::arc<E>> const& arcs) -> void {
+				for (auto const& [to, w] : arcs) {
+					target.push_back(to);
+					weight.push_back(w);
+				}
+				first.push_back(target.size());
+			}
+		};
+
+		// One direction of a query. Distances are reset after each query through touched, so
+		// only the first query to use them pays for the arrays.
+		struct search {
+			std::vector<E> distance;
+			std::vector<std::size_t> touched;
+			std::vector<std::pair<E, std::size_t>> queue;
+
+			auto start(std::size_t source, std::size_t size) -> void {
+				if (distance.size() < size) {
+					distance.resize(size, unreachable<E>);
+				}
+				reach(source, E{});
+			}
+
+			// Whether anything queued could still improve on best.
+			[[nodiscard]] auto open(E best) const -> bool {
+				return !queue.empty() && next() < best;
+			}
+
+			[[nodiscard]] auto next() const -> E {
+				return queue.front().first;
+			}
+
+			// Settles the closest queued level, meeting the other direction there if it has
+			// reached it too. If a higher level already reached gets there more cheaply through
+			// one of the reverse edges in stall, no shortest path can go on from here, so its
+			// edges are not followed (stall-on-demand).
+			auto settle(upward_graph const& g,
+			            upward_graph const& stall,
+			            search const& other,
+			            E& best) -> void {
+				std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+				auto const [d, from] = queue.back();
+				queue.pop_back();
+				if (distance[from] < d) {
+					return;
+				}
+				if (other.distance[from] != unreachable<E>) {
+					best = std::min(best, static_cast<E>(d + other.distance[from]));
+				}
+				for (auto edge = stall.first[from]; edge < stall.first[from + 1]; ++edge) {
+					auto const higher = distance[stall.target[edge]];
+					if (higher != unreachable<E> && static_cast<E>(higher + stall.weight[edge]) < d) {
+						return;
+					}
+				}
+				for (auto edge = g.first[from]; edge < g.first[from + 1]; ++edge) {
+					auto const candidate = static_cast<E>(d + g.weight[edge]);
+					if (candidate < distance[g.target[edge]]) {
+						reach(g.target[edge], candidate);
+					}
+				}
+			}
+
+			auto reach(std::size_t level, E d) -> void {
+				if (distance[level] == unreachable<E>) {
+					touched.push_back(level);
+				}
+				distance[level] = d;
+				queue.emplace_back(d, level);
+				std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+			}
+
+			auto finish() -> void {
+				for (auto const level : touched) {
+					distance[level] = unreachable<E>;
+				}
+				touched.clear();
+				queue.clear();
+			}
+		};
+
+		// Both directions of a query for every query that has finished, kept for the next ones
+		// so concurrent queries each get their own. A copy of the hierarchy starts without any.
+		class scratch {
+		public:
+			using searches = std::array<search, 2>;
+
+			scratch() = default;
+
+			scratch(scratch const&) noexcept {}
+
+			auto operator=(scratch const&) noexcept -> scratch& {
+				return *this;
+			}
+
+			[[nodiscard]] auto take() -> std::unique_ptr<searches> {
+				auto const lock = std::scoped_lock(mutex_);
+				if (spare_.empty()) {
+					return std::make_unique<searches>();
+				}
+				auto result = std::move(spare_.back());
+				spare_.pop_back();
+				return result;
+			}
+
+			auto give_back(std::unique_ptr<searches> used) -> void {
+				auto const lock = std::scoped_lock(mutex_);
+				spare_.push_back(std::move(used));
+			}
+
+		private:
+			std::mutex mutex_;
+			std::vector<std::unique_ptr<searches>> spare_;
+		};
+
+		std::vector<N> nodes_;
+		std::vector<std::size_t> level_;
+		upward_graph up_;
+		upward_graph down_;
+		mutable scratch scratch_;
+
+		template<node_key<N> K>
+		[[nodiscard]] auto rank(K const& key) const -> std::size_t {
+			return detail::find_rank<N>(nodes_, key);
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_CONTRACTION_HPP
@@ -0,0 +1,341 @@
+#ifndef GDWG_DAG_HPP
+#define GDWG_DAG_HPP
+
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A gdwg::graph that is kept acyclic, together with a topological order of its nodes that is
+	// updated as edges go in rather than recomputed.
+	//
+	// An edge whose source already comes before its destination costs nothing extra. Otherwise
+	// only the nodes ordered between the two are searched, forwards from dst and backwards from
+	// src, and the ones found are shuffled among their own positions (Pearce and Kelly); if the
+	// forward search reaches src, the edge would close a cycle and is rejected before anything
+	// changes. Removing nodes and edges never invalidates the order.
+	//
+	// Only the modifiers that can keep the graph acyclic are offered; everything else is read
+	// through as_graph().
+	template<typename N, typename E, typename Storage = tree_storage>
+	class dag {
+		static constexpr auto weighted = !std::is_void_v<E>;
+		using weight_type = std::conditional_t<weighted, E, detail::no_weight>;
+
+	public:
+		// ########### constructors ###########
+		dag() = default;
+
+		dag(std::initializer_list<N> i_list)
+		: dag(i_list.begin(), i_list.end()) {}
+
+		template<typename InputIt>
+		dag(InputIt first, InputIt last) {
+			std::for_each(first, last, [this](auto const& n) { insert_node(n); });
+		}
+
+		dag(dag&& other) = default;
+
+		auto operator=(dag&& other) -> dag& = default;
+
+		dag(dag const& other)
+		: graph_{other.graph_}
+		, index_{other.index_}
+		, slots_{other.slots_}
+		, free_{other.free_}
+		, order_{other.order_} {
+			// each slot points at its key in index_, so re-point them at this copy's keys
+			for (auto const& [value, slot] : index_) {
+				slots_[slot].value = &value;
+			}
+		}
+
+		auto operator=(dag const& other) -> dag& {
+			return *this = dag(other);
+		}
+
+		// ########### Modifiers ###########
+		// New nodes go last in the order.
+		auto insert_node(N const& value) -> bool {
+			if (!graph_.insert_node(value)) {
+				return false;
+			}
+			auto slot = slots_.size();
+			if (free_.empty()) {
+				slots_.emplace_back();
+			}
+			else {
+				slot = free_.back();
+				free_.pop_back();
+			}
+			slots_[slot].value = &index_.emplace(value, slot).first->first;
+			slots_[slot].position = order_.size();
+			order_.push_back(slot);
+			return true;
+		}
+
+		auto insert_edge(N const& src, N const& dst, weight_type const& weight) -> bool
+		requires weighted {
+			return insert_edge_impl(src, dst, weight);
+		}
+
+		auto insert_edge(N const& src, N const& dst) -> bool
+		requires(!weighted) {
+			return insert_edge_impl(src, dst, weight_type());
+		}
+
+		auto erase_node(N const& value) -> bool {
+			auto const it = index_.find(value);
+			if (it == index_.end()) {
+				return false;
+			}
+			auto const slot = it->second;
+			for (auto const to : slots_[slot].out) {
+				erase_one(slots_[to].in, slot);
+			}
+			for (auto const from : slots_[slot].in) {
+				erase_one(slots_[from].out, slot);
+			}
+			graph_.erase_node(value);
+			index_.erase(it);
+
+			// close the gap so positions stay dense
+			auto const position = slots_[slot].position;
+			order_.erase(order_.begin() + static_cast<std::ptrdiff_t>(position));
+			for (auto i = position; i < order_.size(); ++i) {
+				slots_[order_[i]].position = i;
+			}
+			slots_[slot] = node_slot{};
+			free_.push_back(slot);
+			return true;
+		}
+
+		auto erase_edge(N const& src, N const& dst, weight_type const& weight) -> bool
+		requires weighted {
+			return erase_edge_impl(src, dst, weight);
+		}
+
+		auto erase_edge(N const& src, N const& dst) -> bool
+		requires(!weighted) {
+			return erase_edge_impl(src, dst, weight_type());
+		}
+
+		auto clear() noexcept -> void {
+			graph_.clear();
+			index_.clear();
+			slots_.clear();
+			free_.clear();
+			order_.clear();
+			marked_.clear();
+			forward_.clear();
+			backward_.clear();
+			stack_.clear();
+		}
+
+		// ########### Accessors ###########
+		[[nodiscard]] auto as_graph() const noexcept -> graph<N, E, Storage> const& {
+			return graph_;
+		}
+
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return index_.find(value) != index_.end();
+		}
+
+		// Every node, each before all the nodes it has edges to.
+		[[nodiscard]] auto order() const -> std::vector<N> {
+			auto nodes = std::vector<N>{};
+			nodes.reserve(order_.size());
+			for (auto const slot : order_) {
+				nodes.push_back(*slots_[slot].value);
+			}
+			return nodes;
+		}
+
+		// Whether lhs comes before rhs in order().
+		[[nodiscard]] auto precedes(N const& lhs, N const& rhs) const -> bool {
+			auto const lhs_it = index_.find(lhs);
+			auto const rhs_it = index_.find(rhs);
+			if (lhs_it == index_.end() || rhs_it == index_.end()) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::precedes if lhs or rhs node "
+				                         "don't exist in the graph");
+			}
+			return slots_[lhs_it->second].position < slots_[rhs_it->second].position;
+		}
+
+		[[nodiscard]] auto operator==(dag const& other) const -> bool {
+			return graph_ == other.graph_;
+		}
+
+	private:
+		// A node's key in index_, its place in order_ and its edges, one entry per edge, so parallel
+		// edges count.
+		struct node_slot {
+			N const* value = nullptr;
+			std::size_t position = 0;
+			std::vector<std::size_t> out;
+			std::vector<std::size_t> in;
+		};
+
+		graph<N, E, Storage> graph_;
+		std::map<N, std::size_t, std::less<>> index_;
+		std::vector<node_slot> slots_;
+		std::vector<std::size_t> free_;
+		// slots by position
+		std::vector<std::size_t> order_;
+		// scratch for reorder, kept to avoid allocating per edge
+		std::vector<char> marked_;
+		std::vector<std::size_t> forward_;
+		std::vector<std::size_t> backward_;
+		std::vector<std::size_t> stack_;
+		std::vector<std::size_t> positions_;
+
+		static auto erase_one(std::vector<std::size_t>& slots, std::size_t slot) -> void {
+			auto const it = std::find(slots.begin(), slots.end(), slot);
+			*it = slots.back();
+			slots.pop_back();
+		}
+
+		auto insert_edge_impl(N const& src, N const& dst, weight_type const& weight) -> bool {
+			auto const src_it = index_.find(src);
+			auto const dst_it = index_.find(dst);
+			if (src_it == index_.end() || dst_it == index_.end()) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::insert_edge when either src or "
+				                         "dst node does not exist");
+			}
+			auto const from = src_it->second;
+			auto const to = dst_it->second;
+			if (slots_[to].position <= slots_[from].position) {
+				reorder(from, to);
+			}
+
+			auto inserted = false;
+			if constexpr (weighted) {
+				inserted = graph_.insert_edge(src, dst, weight);
+			}
+			else {
+				inserted = graph_.insert_edge(src, dst);
+			}
+			if (inserted) {
+				slots_[from].out.push_back(to);
+				slots_[to].in.push_back(from);
+			}
+			return inserted;
+		}
+
+		auto erase_edge_impl(N const& src, N const& dst, weight_type const& weight) -> bool {
+			if (!is_node(src) || !is_node(dst)) {
+				throw std::runtime_error("Cannot call gdwg::dag<N, E>::erase_edge on src or dst if "
+				                         "they don't exist in the graph");
+			}
+			auto erased = false;
+			if constexpr (weighted) {
+				erased = graph_.erase_edge(src, dst, weight);
+			}
+			else {
+				erased = graph_.erase_edge(src, dst);
+				static_cast<void>(weight);
+			}
+			if (erased) {
+				auto const from = index_.find(src)->second;
+				auto const to = index_.find(dst)->second;
+				erase_one(slots_[from].out, to);
+				erase_one(slots_[to].in, from);
+			}
+			return erased;
+		}
+
+		[[nodiscard]] static auto cycle_error() -> std::runtime_error {
+			return std::runtime_error("Cannot call gdwg::dag<N, E>::insert_edge if the edge would "
+			                          "create a cycle");
+		}
+
+		// Makes room for an edge from -> to where to does not yet come after from, or throws if
+		// to already reaches from.
+		auto reorder(std::size_t from, std::size_t to) -> void {
+			if (from == to) {
+				throw cycle_error();
+			}
+			// slots left over from the last reorder may no longer exist
+			forward_.clear();
+			backward_.clear();
+			stack_.clear();
+			auto const lower = slots_[to].position;
+			auto const upper = slots_[from].position;
+			marked_.resize(slots_.size());
+			if (!collect(to, lower, upper, true, forward_)) {
+				for (auto const slot : forward_) {
+					marked_[slot] = 0;
+				}
+				for (auto const slot : stack_) {
+					marked_[slot] = 0;
+				}
+				throw cycle_error();
+			}
+			collect(from, lower, upper, false, backward_);
+
+			// the nodes that reach from move ahead of the ones to reaches, each group keeping its
+			// own order, and together they reuse the positions they already held
+			auto const by_position = [this](std::size_t lhs, std::size_t rhs) {
+				return slots_[lhs].position < slots_[rhs].position;
+			};
+			std::sort(forward_.begin(), forward_.end(), by_position);
+			std::sort(backward_.begin(), backward_.end(), by_position);
+			positions_.clear();
+			for (auto const& group : {std::cref(backward_), std::cref(forward_)}) {
+				for (auto const slot : group.get()) {
+					positions_.push_back(slots_[slot].position);
+				}
+			}
+			std::sort(positions_.begin(), positions_.end());
+
+			auto next = positions_.cbegin();
+			for (auto const& group : {std::cref(backward_), std::cref(forward_)}) {
+				for (auto const slot : group.get()) {
+					marked_[slot] = 0;
+					slots_[slot].position = *next;
+					order_[*next] = slot;
+					++next;
+				}
+			}
+		}
+
+		// Collects the nodes reachable from start, along out-edges if forward and in-edges
+		// otherwise, that sit strictly between positions lower and upper. Returns false if a
+		// forward search reaches the node at upper.
+		auto collect(std::size_t start,
+		             std::size_t lower,
+		             std::size_t upper,
+		             bool forward,
+		             std::vector<std::size_t>& found) -> bool {
+			found.clear();
+			stack_.assign(1, start);
+			marked_[start] = 1;
+			while (!stack_.empty()) {
+				auto const slot = stack_.back();
+				stack_.pop_back();
+				found.push_back(slot);
+				for (auto const neighbour : forward ? slots_[slot].out : slots_[slot].in) {
+					auto const position = slots_[neighbour].position;
+					if (forward && position == upper) {
+						return false;
+					}
+					if (!marked_[neighbour] && lower < position && position < upper) {
+						marked_[neighbour] = 1;
+						stack_.push_back(neighbour);
+					}
+				}
+			}
+			return true;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_DAG_HPP
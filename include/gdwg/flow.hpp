@@ -0,0 +1,332 @@
+#ifndef GDWG_FLOW_HPP
+#define GDWG_FLOW_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/neighbourhood.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	// A maximum flow: its value, and the flow along each edge in the graph's iteration order.
+	template<typename W>
+	struct maximum_flow {
+		W value;
+		std::vector<W> flow;
+	};
+
+	namespace detail {
+		// Highest-label push-relabel (Goldberg and Tarjan) over a residual network with one arc
+		// each way between every pair of neighbours, however many edges join them.
+		template<typename E>
+		class push_relabel {
+		public:
+			template<typename N>
+			explicit push_relabel(frozen_graph<N, E> const& g)
+			: size_(g.size())
+			, first_arc_(g.size() + 1)
+			, excess_(g.size())
+			, label_(g.size())
+			, current_(g.size())
+			, next_(g.size())
+			, previous_(g.size())
+			, first_at_(g.size(), no_rank)
+			, active_(g.size()) {
+				for (auto rank = std::size_t{0}; rank < size_; ++rank) {
+					first_arc_[rank] = head_.size();
+					auto const neighbours = g.out_neighbours(rank);
+					auto const weights = g.out_weights(rank);
+					auto edge = std::size_t{0};
+					for_each_neighbour(g, rank, [&](std::size_t next) {
+						auto capacity = E{};
+						for (; edge < neighbours.size() && neighbours[edge] <= next; ++edge) {
+							if (neighbours[edge] == next) {
+								capacity += weights[edge];
+							}
+						}
+						head_.push_back(next);
+						capacity_.push_back(capacity);
+					});
+				}
+				first_arc_[size_] = head_.size();
+				residual_ = capacity_;
+
+				// each node's arcs are sorted by head, so the way back is found by binary search
+				auto const at = [this](std::size_t arc) {
+					return head_.cbegin() + static_cast<std::ptrdiff_t>(arc);
+				};
+				partner_.resize(head_.size());
+				for (auto rank = std::size_t{0}; rank < size_; ++rank) {
+					for (auto arc = first_arc_[rank]; arc < first_arc_[rank + 1]; ++arc) {
+						auto const to = head_[arc];
+						auto const back =
+						   std::lower_bound(at(first_arc_[to]), at(first_arc_[to + 1]), rank);
+						partner_[arc] = static_cast<std::size_t>(back - head_.cbegin());
+					}
+				}
+			}
+
+			// Sends as much as can reach sink from source, leaving the rest as excess on the nodes
+			// that cannot reach sink.
+			auto saturate(std::size_t source, std::size_t sink) -> void {
+				for (auto arc = first_arc_[source]; arc < first_arc_[source + 1]; ++arc) {
+					push(arc, residual_[arc]);
+				}
+				discharge_all(source, sink);
+			}
+
+			// Returns every node's excess, other than source's and sink's, to sink.
+			auto drain(std::size_t source, std::size_t sink) -> void {
+				discharge_all(source, sink);
+			}
+
+			[[nodiscard]] auto excess(std::size_t rank) const -> E {
+				return excess_[rank];
+			}
+
+			[[nodiscard]] auto first_arc(std::size_t rank) const -> std::size_t {
+				return first_arc_[rank];
+			}
+
+			[[nodiscard]] auto head(std::size_t arc) const -> std::size_t {
+				return head_[arc];
+			}
+
+			// The net flow along arc, negative if it runs the other way.
+			[[nodiscard]] auto flow(std::size_t arc) const -> E {
+				return static_cast<E>(capacity_[arc] - residual_[arc]);
+			}
+
+		private:
+			std::size_t size_;
+			std::vector<std::size_t> first_arc_;
+			std::vector<std::size_t> head_;
+			std::vector<std::size_t> partner_;
+			std::vector<E> capacity_;
+			std::vector<E> residual_;
+			std::vector<E> excess_;
+			std::vector<std::size_t> label_;
+			std::vector<std::size_t> current_;
+			// every labelled node is in a doubly linked list of the nodes with its label
+			std::vector<std::size_t> next_;
+			std::vector<std::size_t> previous_;
+			std::vector<std::size_t> first_at_;
+			// nodes with excess by label; an entry is stale once its node's label or excess moved
+			std::vector<std::vector<std::size_t>> active_;
+			std::size_t max_label_ = 0;
+			std::size_t max_active_ = 0;
+			std::size_t work_ = 0;
+
+			auto push(std::size_t arc, E amount) -> void {
+				residual_[arc] -= amount;
+				residual_[partner_[arc]] += amount;
+				excess_[head_[arc]] += amount;
+				excess_[head_[partner_[arc]]] -= amount;
+			}
+
+			auto link(std::size_t rank, std::size_t label) -> void {
+				label_[rank] = label;
+				previous_[rank] = no_rank;
+				next_[rank] = first_at_[label];
+				if (next_[rank] != no_rank) {
+					previous_[next_[rank]] = rank;
+				}
+				first_at_[label] = rank;
+				max_label_ = std::max(max_label_, label);
+			}
+
+			auto unlink(std::size_t rank) -> void {
+				if (previous_[rank] == no_rank) {
+					first_at_[label_[rank]] = next_[rank];
+				}
+				else {
+					next_[previous_[rank]] = next_[rank];
+				}
+				if (next_[rank] != no_rank) {
+					previous_[next_[rank]] = previous_[rank];
+				}
+			}
+
+			auto activate(std::size_t rank) -> void {
+				active_[label_[rank]].push_back(rank);
+				max_active_ = std::max(max_active_, label_[rank]);
+			}
+
+			// Labels every node with its exact distance to sink in the residual network, by a
+			// backwards breadth-first search. Nodes that cannot reach it get size_, which takes them
+			// out of play, as does source.
+			auto global_relabel(std::size_t source, std::size_t sink) -> void {
+				std::fill(label_.begin(), label_.end(), size_);
+				std::fill(first_at_.begin(), first_at_.end(), no_rank);
+				for (auto& bucket : active_) {
+					bucket.clear();
+				}
+				max_label_ = 0;
+				max_active_ = 0;
+				work_ = 0;
+
+				auto queue = std::vector<std::size_t>{sink};
+				label_[sink] = 0;
+				for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+					auto const to = queue[i];
+					for (auto arc = first_arc_[to]; arc < first_arc_[to + 1]; ++arc) {
+						auto const from = head_[arc];
+						if (label_[from] == size_ && from != source && residual_[partner_[arc]] > E{}) {
+							link(from, label_[to] + 1);
+							current_[from] = first_arc_[from];
+							if (excess_[from] > E{}) {
+								activate(from);
+							}
+							queue.push_back(from);
+						}
+					}
+				}
+			}
+
+			// Lifts rank just above its lowest residual neighbour. If it was the last node with its
+			// old label, nothing above that label can reach the sink any more (the gap heuristic),
+			// so all of them are taken out of play at once.
+			auto relabel(std::size_t rank) -> void {
+				auto const old = label_[rank];
+				unlink(rank);
+				if (first_at_[old] == no_rank) {
+					for (auto label = old; label <= max_label_; ++label) {
+						for (auto node = first_at_[label]; node != no_rank; node = next_[node]) {
+							label_[node] = size_;
+						}
+						first_at_[label] = no_rank;
+					}
+					label_[rank] = size_;
+					max_label_ = old - 1;
+					return;
+				}
+
+				auto lowest = size_;
+				for (auto arc = first_arc_[rank]; arc < first_arc_[rank + 1]; ++arc) {
+					if (residual_[arc] > E{}) {
+						lowest = std::min(lowest, label_[head_[arc]] + 1);
+					}
+				}
+				// the arcs scanned, plus a constant for the relabel itself as in Cherkassky and
+				// Goldberg's implementation
+				work_ += first_arc_[rank + 1] - first_arc_[rank] + 12;
+				current_[rank] = first_arc_[rank];
+				if (lowest < size_) {
+					link(rank, lowest);
+				}
+				else {
+					label_[rank] = size_;
+				}
+			}
+
+			// Pushes rank's excess along admissible arcs, relabelling it whenever it runs out of
+			// them, until the excess is gone or rank is out of play.
+			auto discharge(std::size_t rank, std::size_t source, std::size_t sink) -> void {
+				while (excess_[rank] > E{} && label_[rank] < size_) {
+					auto const arc = current_[rank];
+					if (arc == first_arc_[rank + 1]) {
+						relabel(rank);
+						continue;
+					}
+					auto const to = head_[arc];
+					if (residual_[arc] > E{} && label_[rank] == label_[to] + 1) {
+						auto const had_excess = excess_[to] > E{};
+						push(arc, std::min(excess_[rank], residual_[arc]));
+						if (!had_excess && to != source && to != sink) {
+							activate(to);
+						}
+					}
+					else {
+						++current_[rank];
+					}
+				}
+			}
+
+			// Discharges the highest active node until none is left, relabelling everything from
+			// scratch once relabels have cost about as much as that would.
+			auto discharge_all(std::size_t source, std::size_t sink) -> void {
+				auto const global_relabel_work = 6 * size_ + head_.size();
+				global_relabel(source, sink);
+				for (;;) {
+					while (max_active_ > 0 && active_[max_active_].empty()) {
+						--max_active_;
+					}
+					if (active_[max_active_].empty()) {
+						return;
+					}
+					auto const label = max_active_;
+					auto const rank = active_[label].back();
+					active_[label].pop_back();
+					if (label_[rank] != label || !(excess_[rank] > E{})) {
+						continue;
+					}
+					discharge(rank, source, sink);
+					if (work_ > global_relabel_work) {
+						global_relabel(source, sink);
+					}
+				}
+			}
+		};
+	} // namespace detail
+
+	// A maximum flow from src to dst, taking edge weights as capacities. Parallel edges share
+	// the flow between their two nodes, each filled in iteration order before the next, and
+	// flow between two nodes only ever runs one way. Self-loops carry nothing.
+	//
+	// Runs highest-label push-relabel with the global relabelling and gap heuristics, over a
+	// residual network with one arc each way between each pair of neighbours. The first phase
+	// finds the value; the second returns the excess stranded on nodes that cannot reach dst
+	// to src, so that every edge's flow is known.
+	template<typename N, typename E, node_key<N> Src, node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto max_flow(frozen_graph<N, E> const& g, Src const& src, Dst const& dst) -> maximum_flow<E> {
+		auto const source = g.rank(src);
+		auto const sink = g.rank(dst);
+		if (source == no_rank || sink == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::max_flow if src or dst node don't exist in "
+			                         "the graph");
+		}
+		if (source == sink) {
+			throw std::runtime_error("Cannot call gdwg::max_flow if src and dst are the same node");
+		}
+		if (g.edge_count() > 0 && g.min_weight() < E{}) {
+			throw std::runtime_error("Cannot call gdwg::max_flow on a graph with negative edge "
+			                         "weights");
+		}
+
+		auto network = detail::push_relabel<E>(g);
+		network.saturate(source, sink);
+		network.drain(sink, source);
+
+		auto result = maximum_flow<E>{network.excess(sink), std::vector<E>(g.edge_count())};
+		for (auto from = std::size_t{0}; from < g.size(); ++from) {
+			auto const neighbours = g.out_neighbours(from);
+			auto const weights = g.out_weights(from);
+			auto edge = std::size_t{0};
+			for (auto arc = network.first_arc(from); arc < network.first_arc(from + 1); ++arc) {
+				auto remaining = network.flow(arc);
+				for (; edge < neighbours.size() && neighbours[edge] <= network.head(arc); ++edge) {
+					if (neighbours[edge] == network.head(arc) && remaining > E{}) {
+						auto const flow = std::min(remaining, weights[edge]);
+						result.flow[g.first_out_edge(from) + edge] = flow;
+						remaining -= flow;
+					}
+				}
+			}
+		}
+		return result;
+	}
+
+	template<typename N, typename E, typename Storage, node_key<N> Src, node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto max_flow(graph<N, E, Storage> const& g, Src const& src, Dst const& dst)
+	   -> maximum_flow<E> {
+		return max_flow(frozen_graph<N, E>(g), src, dst);
+	}
+} // namespace gdwg
+
+#endif // GDWG_FLOW_HPP
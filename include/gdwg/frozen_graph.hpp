@@ -0,0 +1,216 @@
+#ifndef GDWG_FROZEN_GRAPH_HPP
+#define GDWG_FROZEN_GRAPH_HPP
+
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	// The rank that stands for "no node", e.g. when a lookup fails or a node has no predecessor.
+	inline constexpr auto no_rank = std::numeric_limits<std::size_t>::max();
+
+	// The distance, or hop count, given to nodes that cannot be reached.
+	template<typename W>
+	inline constexpr auto unreachable = std::numeric_limits<W>::has_infinity
+	                                       ? std::numeric_limits<W>::infinity()
+	                                       : std::numeric_limits<W>::max();
+
+	namespace detail {
+		// The sum of two non-negative distances, or unreachable<W> if it does not fit in W. Floating
+		// sums reach infinity by themselves; integral ones would wrap, onto a false shorter path.
+		template<typename W>
+		[[nodiscard]] constexpr auto saturating_add(W lhs, W rhs) noexcept -> W {
+			if constexpr (std::is_integral_v<W>) {
+				if (rhs > static_cast<W>(unreachable<W> - lhs)) {
+					return unreachable<W>;
+				}
+			}
+			return static_cast<W>(lhs + rhs);
+		}
+
+		// The index of the node equal to key among nodes, which are ascending, or no_rank if there
+		// is none. As in graph::find_node, an arithmetic key that N cannot hold exactly names no
+		// node, and any other is converted to N first, so mixed signs compare by value.
+		template<typename N, typename K>
+		[[nodiscard]] auto find_rank(std::span<N const> nodes, K const& key) -> std::size_t {
+			if constexpr (std::is_arithmetic_v<K> && std::is_integral_v<N> && !std::is_same_v<K, N>) {
+				return representable<N>(key) ? find_rank(nodes, static_cast<N>(key)) : no_rank;
+			}
+			else {
+				auto const it = std::lower_bound(nodes.begin(),
+				                                 nodes.end(),
+				                                 key,
+				                                 [](N const& lhs, K const& rhs) { return lhs < rhs; });
+				if (it == nodes.end() || key < *it) {
+					return no_rank;
+				}
+				return static_cast<std::size_t>(it - nodes.begin());
+			}
+		}
+	} // namespace detail
+
+	// An immutable snapshot of a gdwg::graph in compressed sparse row form, for algorithms that
+	// need to scan adjacency many times.
+	//
+	// Nodes are numbered by rank, their position in graph::nodes(), and edges are numbered in the
+	// graph's iteration order, so node u's out-edges are [first_out_edge(u), first_out_edge(u + 1)).
+	// Every edge is also indexed by destination, which gives in-edges and in-degrees for free.
+	// Parallel edges are kept as they are. The snapshot does not follow later changes to the graph.
+	template<typename N, typename E>
+	class frozen_graph {
+		static constexpr auto weighted = !std::is_void_v<E>;
+		using weight_type = std::conditional_t<weighted, E, detail::no_weight>;
+
+	public:
+		using size_type = std::size_t;
+
+		template<typename Storage>
+		explicit frozen_graph(graph<N, E, Storage> const& g) {
+			auto const& storage = g.storage_;
+			for (auto node = storage.node_begin(); node != storage.node_end(); ++node) {
+				nodes_.push_back(storage.value(node));
+			}
+
+			out_offsets_.reserve(nodes_.size() + 1);
+			out_offsets_.push_back(0);
+			for (auto node = storage.node_begin(); node != storage.node_end(); ++node) {
+				// destinations are ascending, so each search can start where the last one ended
+				auto hint = nodes_.cbegin();
+				for (auto e = storage.edge_begin(node); e != storage.edge_end(node); ++e) {
+					hint = std::lower_bound(hint, nodes_.cend(), storage.destination(e));
+					targets_.push_back(static_cast<size_type>(hint - nodes_.cbegin()));
+					if constexpr (weighted) {
+						auto const& weight = storage.weight(e);
+						if (weights_.empty() || weight < min_weight_) {
+							min_weight_ = weight;
+						}
+						if (weights_.empty() || max_weight_ < weight) {
+							max_weight_ = weight;
+						}
+						weights_.push_back(weight);
+					}
+				}
+				out_offsets_.push_back(targets_.size());
+			}
+
+			build_in_edges();
+		}
+
+		[[nodiscard]] auto size() const noexcept -> size_type {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto edge_count() const noexcept -> size_type {
+			return targets_.size();
+		}
+
+		// Nodes in ascending order; a node's rank is its index here.
+		[[nodiscard]] auto nodes() const noexcept -> std::vector<N> const& {
+			return nodes_;
+		}
+
+		[[nodiscard]] auto node(size_type rank) const -> N const& {
+			return nodes_[rank];
+		}
+
+		// The rank of the node equal to key, or no_rank if there is none.
+		template<node_key<N> K = N>
+		[[nodiscard]] auto rank(K const& key) const -> size_type {
+			return detail::find_rank<N>(nodes_, key);
+		}
+
+		[[nodiscard]] auto out_degree(size_type rank) const -> size_type {
+			return out_offsets_[rank + 1] - out_offsets_[rank];
+		}
+
+		[[nodiscard]] auto in_degree(size_type rank) const -> size_type {
+			return in_offsets_[rank + 1] - in_offsets_[rank];
+		}
+
+		[[nodiscard]] auto first_out_edge(size_type rank) const -> size_type {
+			return out_offsets_[rank];
+		}
+
+		[[nodiscard]] auto target(size_type edge) const -> size_type {
+			return targets_[edge];
+		}
+
+		[[nodiscard]] auto weight(size_type edge) const -> weight_type const&
+		requires weighted {
+			return weights_[edge];
+		}
+
+		// The smallest and largest edge weights, or E() if there are no edges.
+		[[nodiscard]] auto min_weight() const -> weight_type const&
+		requires weighted {
+			return min_weight_;
+		}
+
+		[[nodiscard]] auto max_weight() const -> weight_type const&
+		requires weighted {
+			return max_weight_;
+		}
+
+		// Destinations of rank's out-edges, ascending.
+		[[nodiscard]] auto out_neighbours(size_type rank) const -> std::span<size_type const> {
+			return std::span(targets_).subspan(out_offsets_[rank], out_degree(rank));
+		}
+
+		// Weights of rank's out-edges, aligned with out_neighbours(rank).
+		[[nodiscard]] auto out_weights(size_type rank) const -> std::span<weight_type const>
+		requires weighted {
+			return std::span(weights_).subspan(out_offsets_[rank], out_degree(rank));
+		}
+
+		// Sources of rank's in-edges, ascending.
+		[[nodiscard]] auto in_neighbours(size_type rank) const -> std::span<size_type const> {
+			return std::span(sources_).subspan(in_offsets_[rank], in_degree(rank));
+		}
+
+		// Edge numbers of rank's in-edges, aligned with in_neighbours(rank).
+		[[nodiscard]] auto in_edges(size_type rank) const -> std::span<size_type const> {
+			return std::span(in_edges_).subspan(in_offsets_[rank], in_degree(rank));
+		}
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<size_type> out_offsets_;
+		std::vector<size_type> targets_;
+		[[no_unique_address]] std::conditional_t<weighted, std::vector<E>, weight_type> weights_;
+		[[no_unique_address]] weight_type min_weight_{};
+		[[no_unique_address]] weight_type max_weight_{};
+		std::vector<size_type> in_offsets_;
+		std::vector<size_type> sources_;
+		std::vector<size_type> in_edges_;
+
+		// Buckets every edge by destination. Sources are visited in ascending order, so each
+		// bucket comes out sorted.
+		auto build_in_edges() -> void {
+			in_offsets_.assign(nodes_.size() + 1, 0);
+			for (auto const to : targets_) {
+				++in_offsets_[to + 1];
+			}
+			for (auto rank = size_type{0}; rank < nodes_.size(); ++rank) {
+				in_offsets_[rank + 1] += in_offsets_[rank];
+			}
+
+			auto next = std::vector<size_type>(in_offsets_.cbegin(), in_offsets_.cend() - 1);
+			sources_.resize(targets_.size());
+			in_edges_.resize(targets_.size());
+			for (auto from = size_type{0}; from < nodes_.size(); ++from) {
+				for (auto edge = out_offsets_[from]; edge < out_offsets_[from + 1]; ++edge) {
+					auto const slot = next[targets_[edge]]++;
+					sources_[slot] = from;
+					in_edges_[slot] = edge;
+				}
+			}
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_FROZEN_GRAPH_HPP
@@ -1,28 +1,85 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
 
+#include <gdwg/storage.hpp>
+
 #include <algorithm>
 #include <iostream>
 #include <iterator>
-#include <list>
-#include <map>
-#include <memory>
-#include <set>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
-// This will not compile straight away
 namespace gdwg {
+	namespace detail {
+		template<typename N, typename E>
+		struct edge_value {
+			N from;
+			N to;
+			E weight;
+		};
+
+		template<typename N>
+		struct edge_value<N, void> {
+			N from;
+			N to;
+		};
+	} // namespace detail
+
 	template<typename N, typename E>
+	class frozen_graph;
+
+	// Told about a graph's changes once subscribed to it (see graph::subscribe). Each hook runs
+	// after the change is made and must not modify the graph or its subscriptions. Erasing a node
+	// also erases its edges without a separate edge_erased for each.
+	template<typename N, typename E>
+	class graph_observer {
+	public:
+		virtual ~graph_observer() = default;
+
+		virtual auto node_inserted(N const&) -> void {}
+
+		virtual auto edge_inserted(detail::edge_value<N, E> const&) -> void {}
+
+		virtual auto node_erased(N const&) -> void {}
+
+		virtual auto edge_erased(detail::edge_value<N, E> const&) -> void {}
+
+		// Any other change, such as clear, replace_node or assignment.
+		virtual auto graph_changed() noexcept -> void {}
+
+		// The graph is being destroyed and must not be used again.
+		virtual auto graph_destroyed() noexcept -> void {}
+	};
+
+	// Storage selects how nodes are indexed and edges laid out (see gdwg/storage.hpp); it never
+	// changes the graph's observable behaviour or ordering.
+	//
+	// E may be void for a graph that only records topology. Edges then carry no weight: they are
+	// inserted, found and erased by src and dst alone, and iteration yields only from and to.
+	//
+	// Functions that look nodes up accept any key comparable with N (see gdwg::node_key), so a
+	// graph of std::string can be queried with a std::string_view or a string literal. The bundled
+	// storages find such keys without constructing an N, except that hash_storage can only hash
+	// string-like keys directly and converts any other key to N first.
+	//
+	// Indexes derived from a graph can keep up with it by subscribing a gdwg::graph_observer.
+	template<typename N, typename E, typename Storage = tree_storage>
 	class graph {
+		static constexpr auto weighted = !std::is_void_v<E>;
+		using weight_type = std::conditional_t<weighted, E, detail::no_weight>;
+		using storage_type = typename Storage::template storage<N, weight_type>;
+		using node_iterator = typename storage_type::node_iterator;
+		using edge_iterator = typename storage_type::edge_iterator;
+		static_assert(graph_storage<storage_type, N, weight_type>,
+		              "Storage::storage<N, E> must model gdwg::graph_storage");
+
 	public:
 		class iterator;
 		// ########### constructors ###########
 		graph() noexcept
-		: nodes_{std::set<std::shared_ptr<N>, node_comparator>()}
-		, edges_{std::map<std::shared_ptr<N>, std::set<edge, edge_comparator>, edge_list_comparator>()} {
-		}
+		: storage_{storage_type()} {}
 
 		graph(std::initializer_list<N> i_list)
 		: graph(i_list.begin(), i_list.end()) {}
@@ -33,76 +90,54 @@ namespace gdwg {
 		}
 
 		graph(graph&& other) noexcept
-		: nodes_{std::exchange(other.nodes_, std::set<std::shared_ptr<N>, node_comparator>())}
-		, edges_{std::exchange(
-		     other.edges_,
-		     std::map<std::shared_ptr<N>, std::set<edge, edge_comparator>, edge_list_comparator>())} {}
+		: storage_{std::exchange(other.storage_, storage_type())} {
+			other.notify_changed();
+		}
 
 		auto operator=(graph&& other) noexcept -> graph& {
-			std::swap(nodes_, other.nodes_);
-			std::swap(edges_, other.edges_);
-
-			other.nodes_ = std::set<std::shared_ptr<N>, node_comparator>();
-			other.edges_ =
-			   std::map<std::shared_ptr<N>, std::set<edge, edge_comparator>, edge_list_comparator>();
-
+			std::swap(storage_, other.storage_);
+			other.storage_ = storage_type();
+			notify_changed();
+			other.notify_changed();
 			return *this;
 		}
 
 		graph(graph const& other)
-		: nodes_{std::set<std::shared_ptr<N>, node_comparator>()}
-		, edges_{std::map<std::shared_ptr<N>, std::set<edge, edge_comparator>, edge_list_comparator>()} {
-			// copy nodes
-			std::for_each(other.nodes_.cbegin(), other.nodes_.cend(), [this](auto const& n) {
-				insert_node(*n);
-			});
-
-			// copy edges
-			std::for_each(other.edges_.cbegin(), other.edges_.cend(), [this](auto const& other_edge_list) {
-				auto src = *(other_edge_list.first);
-				std::for_each(other_edge_list.second.begin(),
-				              other_edge_list.second.end(),
-				              [src, this](auto const& other_edge) {
-					              auto dst_it = nodes_.find(*(other_edge.to));
-					              auto edge_list_it = edges_.find(src);
-					              auto new_edge = edge{*dst_it, other_edge.weight};
-					              edge_list_it->second.emplace(new_edge);
-				              });
-			});
-		}
+		: storage_{other.storage_} {}
 
 		auto operator=(graph const& other) -> graph& {
 			graph(other).swap(*this);
+			notify_changed();
 			return *this;
 		}
 
+		~graph() {
+			for (auto* const observer : observers_) {
+				observer->graph_destroyed();
+			}
+		}
+
 		// ########### Modifiers ###########
 		auto insert_node(N const& value) -> bool {
-			if (is_node(value)) {
+			if (!storage_.insert_node(value)) {
 				return false;
 			}
-			auto node = std::make_shared<N>(value);
-			nodes_.emplace(node);
-			edges_.emplace(node, std::set<edge, edge_comparator>());
+			for (auto* const observer : observers_) {
+				observer->node_inserted(value);
+			}
 			return true;
 		}
 
-		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
-				                         "or dst node does not exist");
-			}
-
-			if (find(src, dst, weight) != end()) {
-				return false;
-			}
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		auto insert_edge(Src const& src, Dst const& dst, weight_type const& weight) -> bool
+		requires weighted {
+			return insert_edge_impl(src, dst, weight);
+		}
 
-			// insert new edges
-			auto dst_it = nodes_.find(dst);
-			auto edge_list_it = edges_.find(src);
-			auto new_edge = edge{*dst_it, weight};
-			edge_list_it->second.emplace(new_edge);
-			return true;
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		auto insert_edge(Src const& src, Dst const& dst) -> bool
+		requires(!weighted) {
+			return insert_edge_impl(src, dst, weight_type());
 		}
 
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
@@ -114,140 +149,76 @@ namespace gdwg {
 				return false;
 			}
 
-			// insert new node
-			insert_node(new_data);
-
-			// replace edges
-			auto old_edge_list_it = edges_.find(old_data);
-			for_each(old_edge_list_it->second.begin(),
-			         old_edge_list_it->second.end(),
-			         [old_data, new_data, this](auto graph_edge) {
-				         if (*(graph_edge.to) == old_data) {
-					         insert_edge(new_data, new_data, graph_edge.weight);
-				         }
-				         else {
-					         insert_edge(new_data, *(graph_edge.to), graph_edge.weight);
-				         }
-			         });
-			old_edge_list_it->second.clear();
-			edges_.erase(old_edge_list_it);
-
-			for (auto edge_list_it = edges_.begin(); edge_list_it != edges_.end(); ++edge_list_it) {
-				for (auto edge_it = edge_list_it->second.begin(); edge_it != edge_list_it->second.end();)
-				{
-					if (*(edge_it->to) == old_data) {
-						insert_edge(*(edge_list_it->first), new_data, edge_it->weight);
-						edge_it = edge_list_it->second.erase(edge_it);
-					}
-					else {
-						++edge_it;
-					}
-				}
-			}
-
-			// remove old node
-			auto old_data_it = nodes_.find(old_data);
-			nodes_.erase(old_data_it);
-
+			// a fresh node has no edges, so replacing is merging into it
+			storage_.insert_node(new_data);
+			merge_replace_node(old_data, new_data);
 			return true;
 		}
 
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			if (!is_node(old_data) || !is_node(new_data)) {
+			auto const old_it = storage_.find_node(old_data);
+			auto const new_it = storage_.find_node(new_data);
+			if (old_it == storage_.node_end() || new_it == storage_.node_end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
 			}
-
-			// replace edges
-			auto old_edge_list_it = edges_.find(old_data);
-			for_each(old_edge_list_it->second.begin(),
-			         old_edge_list_it->second.end(),
-			         [old_data, new_data, this](auto graph_edge) {
-				         if (*(graph_edge.to) == old_data) {
-					         insert_edge(new_data, new_data, graph_edge.weight);
-				         }
-				         else {
-					         insert_edge(new_data, *(graph_edge.to), graph_edge.weight);
-				         }
-			         });
-			old_edge_list_it->second.clear();
-			edges_.erase(old_edge_list_it);
-
-			for (auto edge_list_it = edges_.begin(); edge_list_it != edges_.end(); ++edge_list_it) {
-				for (auto edge_it = edge_list_it->second.begin(); edge_it != edge_list_it->second.end();)
-				{
-					if (*(edge_it->to) == old_data) {
-						insert_edge(*(edge_list_it->first), new_data, edge_it->weight);
-						edge_it = edge_list_it->second.erase(edge_it);
-					}
-					else {
-						++edge_it;
-					}
+			if (old_it == new_it) {
+				return;
+			}
+
+			// collect every edge touching old_data, re-pointed at new_data
+			auto moved = std::vector<detail::edge_value<N, weight_type>>{};
+			for (auto node = storage_.node_begin(); node != storage_.node_end(); ++node) {
+				auto const is_old = node == old_it;
+				auto const [first, last] = is_old
+				                              ? std::pair(storage_.edge_begin(node), storage_.edge_end(node))
+				                              : storage_.edges_to(node, old_it);
+				for (auto e = first; e != last; ++e) {
+					auto const& to = storage_.destination(e);
+					moved.push_back({is_old ? new_data : storage_.value(node),
+					                 to == old_data ? new_data : to,
+					                 storage_.weight(e)});
 				}
 			}
 
-			// remove old node
-			auto old_data_it = nodes_.find(old_data);
-			nodes_.erase(old_data_it);
+			storage_.erase_node(old_it);
+
+			// duplicates of edges new_data already had are dropped by the storage
+			for (auto const& [from, to, weight] : moved) {
+				storage_.insert_edge(storage_.find_node(from), storage_.find_node(to), weight);
+			}
+			notify_changed();
 		}
 
-		auto erase_node(N const& value) -> bool {
-			if (!is_node(value)) {
+		template<node_key<N> K = N>
+		auto erase_node(K const& value) -> bool {
+			auto const node = find_node(value);
+			if (node == storage_.node_end()) {
 				return false;
 			}
-
-			// remove edges
-			auto node_to_erase_it = nodes_.find(value);
-			for (auto edge_list_it = edges_.begin(); edge_list_it != edges_.end();) {
-				auto node = *(edge_list_it->first);
-
-				if (node == value) {
-					// remove outcoming edges of node
-					edge_list_it->second.clear();
-					edge_list_it = edges_.erase(edge_list_it);
-				}
-				else {
-					// remove incoming edge of node
-					for (auto edge_it = edge_list_it->second.begin();
-					     edge_it != edge_list_it->second.end();) {
-						if (*(edge_it->to) == value) {
-							edge_it = edge_list_it->second.erase(edge_it);
-						}
-						else {
-							++edge_it;
-						}
-					}
-					++edge_list_it;
-				}
+			if (observers_.empty()) {
+				storage_.erase_node(node);
+				return true;
 			}
 
-			// remvoe node
-			nodes_.erase(node_to_erase_it);
+			auto const erased = storage_.value(node);
+			storage_.erase_node(node);
+			for (auto* const observer : observers_) {
+				observer->node_erased(erased);
+			}
 			return true;
 		}
 
-		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
-				                         "they don't exist in the graph");
-			}
-
-			// find edge list of src
-			auto edge_list_it = edges_.find(src);
-
-			// find edge in edge list
-			auto dst_it = nodes_.find(dst);
-			auto find_edge = edge{*dst_it, weight};
-			auto edge_it = edge_list_it->second.find(find_edge);
-
-			// if edge does not exist
-			if (edge_it == edge_list_it->second.end()) {
-				return false;
-			}
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		auto erase_edge(Src const& src, Dst const& dst, weight_type const& weight) -> bool
+		requires weighted {
+			return erase_edge_impl(src, dst, weight);
+		}
 
-			// remove edge
-			edge_list_it->second.erase(edge_it);
-			return true;
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		auto erase_edge(Src const& src, Dst const& dst) -> bool
+		requires(!weighted) {
+			return erase_edge_impl(src, dst, weight_type());
 		}
 
 		auto erase_edge(iterator graph_it) -> iterator;
@@ -255,177 +226,252 @@ namespace gdwg {
 		auto erase_edge(iterator it_from, iterator it_to) -> iterator;
 
 		auto clear() noexcept -> void {
-			nodes_.clear();
-			edges_.clear();
+			storage_.clear();
+			notify_changed();
 		}
 
 		// ########### Accessors  ###########
-		[[nodiscard]] auto is_node(N const& value) -> bool {
-			auto node = nodes_.find(value);
-			return node != nodes_.end();
+		template<node_key<N> K = N>
+		[[nodiscard]] auto is_node(K const& value) const -> bool {
+			return find_node(value) != storage_.node_end();
 		}
 
-		[[nodiscard]] auto empty() -> bool {
-			return nodes_.empty();
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return storage_.empty();
 		}
 
-		[[nodiscard]] auto is_connected(N const& src, N const& dst) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto is_connected(Src const& src, Dst const& dst) const -> bool {
+			auto const src_it = find_node(src);
+			auto const dst_it = find_node(dst);
+			if (src_it == storage_.node_end() || dst_it == storage_.node_end()) {
 				return false;
 			}
 
-			auto edge_list_it = edges_.find(src);
-			for (auto edge_it = edge_list_it->second.cbegin(); edge_it != edge_list_it->second.cend();
-			     ++edge_it)
-			{
-				if (*(edge_it->to) == dst) {
-					return true;
-				}
-			}
-			return false;
+			auto const [first, last] = storage_.edges_to(src_it, dst_it);
+			return first != last;
 		}
 
-		[[nodiscard]] auto nodes() -> std::vector<N> {
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			auto nodes_vec = std::vector<N>{};
-			std::for_each(nodes_.cbegin(), nodes_.cend(), [&nodes_vec](auto const& n) {
-				nodes_vec.push_back(*n);
-			});
+			for (auto node = storage_.node_begin(); node != storage_.node_end(); ++node) {
+				nodes_vec.push_back(storage_.value(node));
+			}
 			return nodes_vec;
 		}
 
-		[[nodiscard]] auto weights(N const& src, N const& dst) -> std::vector<E> {
-			if (!is_node(src) || !is_node(dst)) {
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto weights(Src const& src, Dst const& dst) const -> std::vector<weight_type>
+		requires weighted {
+			auto const src_it = find_node(src);
+			auto const dst_it = find_node(dst);
+			if (src_it == storage_.node_end() || dst_it == storage_.node_end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
 				                         "don't exist in the graph");
 			}
 
-			auto weights_vec = std::vector<E>{};
-			auto edge_list_it = edges_.find(src);
-
-			for_each(edge_list_it->second.cbegin(),
-			         edge_list_it->second.cend(),
-			         [dst, &weights_vec](auto const& graph_edge) {
-				         if (*(graph_edge.to) == dst) {
-					         weights_vec.push_back(graph_edge.weight);
-				         }
-			         });
-
+			auto weights_vec = std::vector<weight_type>{};
+			auto const [first, last] = storage_.edges_to(src_it, dst_it);
+			for (auto e = first; e != last; ++e) {
+				weights_vec.push_back(storage_.weight(e));
+			}
 			return weights_vec;
 		}
 
-		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) -> iterator {
-			if (!is_node(src) || !is_node(dst)) {
-				return end();
-			}
-
-			// find edge list of src
-			auto edge_list_it = edges_.find(src);
-			if (edge_list_it->second.empty()) {
-				return end();
-			}
-
-			// find edge
-			auto dst_it = nodes_.find(dst);
-			auto find_edge = edge{*dst_it, weight};
-			auto res = edge_list_it->second.find(find_edge);
-			if (res == edge_list_it->second.end()) {
-				return end();
-			}
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto find(Src const& src, Dst const& dst, weight_type const& weight) const
+		   -> iterator
+		requires weighted {
+			return find_impl(src, dst, weight);
+		}
 
-			return iterator(edge_list_it, edges_.begin(), edges_.end(), res);
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto find(Src const& src, Dst const& dst) const -> iterator
+		requires(!weighted) {
+			return find_impl(src, dst, weight_type());
 		}
 
-		[[nodiscard]] auto connections(N const& src) -> std::vector<N> {
-			if (!is_node(src)) {
+		template<node_key<N> K = N>
+		[[nodiscard]] auto connections(K const& src) const -> std::vector<N> {
+			auto const src_it = find_node(src);
+			if (src_it == storage_.node_end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
 				                         "exist in the graph");
 			}
 
+			// edges are ordered by destination, so parallel edges are adjacent
 			auto conn_vec = std::vector<N>{};
-			auto edge_list_it = edges_.find(src);
-
-			for_each(edge_list_it->second.cbegin(),
-			         edge_list_it->second.cend(),
-			         [&conn_vec](auto const& graph_edge) {
-				         if (std::find(conn_vec.begin(), conn_vec.end(), *(graph_edge.to))
-				             == conn_vec.end()) {
-					         conn_vec.push_back(*(graph_edge.to));
-				         }
-			         });
-
+			for (auto e = storage_.edge_begin(src_it); e != storage_.edge_end(src_it); ++e) {
+				if (conn_vec.empty() || conn_vec.back() != storage_.destination(e)) {
+					conn_vec.push_back(storage_.destination(e));
+				}
+			}
 			return conn_vec;
 		}
 
+		// The subgraph induced by the nodes in [first, last): a new graph holding just those nodes
+		// and every edge between two of them. Nodes may be given in any order and more than once.
+		//
+		// Only the given nodes' out-edges are visited, and nothing is looked up in either graph to
+		// test their destinations. Integral nodes packed closely enough get a table of ranks by
+		// value. Otherwise, as a node's destinations ascend, each is found among the sorted nodes
+		// by a search starting where the last one ended. Nodes and edges arrive in order, so they
+		// are appended rather than inserted wherever the storage supports it.
+		template<typename InputIt>
+		[[nodiscard]] auto induced_subgraph(InputIt first, InputIt last) const -> graph {
+			auto members = std::vector<node_iterator>{};
+			for (; first != last; ++first) {
+				auto const node = find_node(*first);
+				if (node == storage_.node_end()) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::induced_subgraph on nodes "
+					                         "that don't exist in the graph");
+				}
+				members.push_back(node);
+			}
+			std::sort(members.begin(), members.end(), [this](node_iterator lhs, node_iterator rhs) {
+				return storage_.value(lhs) < storage_.value(rhs);
+			});
+			members.erase(std::unique(members.begin(), members.end()), members.end());
+
+			auto values = std::vector<N>{};
+			values.reserve(members.size());
+			for (auto const node : members) {
+				values.push_back(storage_.value(node));
+			}
+			auto const ranks = rank_table(values);
+
+			auto result = graph();
+			auto& built = result.storage_;
+			for (auto const& value : values) {
+				append_node(built, value);
+			}
+			// the new graph holds just the members in the same order, so ranks index both
+			auto built_nodes = std::vector<node_iterator>{};
+			if constexpr (appends_edges) {
+				built_nodes.reserve(members.size());
+				for (auto node = built.node_begin(); node != built.node_end(); ++node) {
+					built_nodes.push_back(node);
+				}
+			}
+			for (auto from = std::size_t{0}; from < members.size(); ++from) {
+				auto hint = values.cbegin();
+				auto const node = members[from];
+				for (auto e = storage_.edge_begin(node); e != storage_.edge_end(node); ++e) {
+					auto const& to = storage_.destination(e);
+					auto const rank = [&] {
+						if constexpr (offsets_by_value) {
+							if (!ranks.empty()) {
+								auto const inside = !(to < values.front()) && !(values.back() < to);
+								return inside ? ranks[offset(values.front(), to)] : values.size();
+							}
+						}
+						hint = std::lower_bound(hint, values.cend(), to);
+						return hint != values.cend() && *hint == to
+						          ? static_cast<std::size_t>(hint - values.cbegin())
+						          : values.size();
+					}();
+					if (rank == values.size()) {
+						continue;
+					}
+					if constexpr (appends_edges) {
+						append_edge(built, built_nodes[from], built_nodes[rank], storage_.weight(e));
+					}
+					else {
+						// each insert_edge may invalidate every node_iterator into the new graph
+						append_edge(built,
+						            built.find_node(values[from]),
+						            built.find_node(to),
+						            storage_.weight(e));
+					}
+				}
+			}
+			return result;
+		}
+
+		// A new graph with the same nodes and every edge reversed, keeping its weight.
+		//
+		// Built in one pass over the edges. Sources are visited in ascending order and each one's
+		// edges come out ordered by destination, so every reversed edge belongs after all those
+		// already at its new source and is appended where the storage supports it. Only the new
+		// source is looked up, once for each run of parallel edges.
+		[[nodiscard]] auto transpose() const -> graph {
+			auto result = graph();
+			auto& built = result.storage_;
+			for (auto node = storage_.node_begin(); node != storage_.node_end(); ++node) {
+				append_node(built, storage_.value(node));
+			}
+			for (auto node = storage_.node_begin(); node != storage_.node_end(); ++node) {
+				auto to = built.find_node(storage_.value(node));
+				auto from = built.node_end();
+				for (auto e = storage_.edge_begin(node); e != storage_.edge_end(node); ++e) {
+					if constexpr (!appends_edges) {
+						// without append_edge, each insert_edge may invalidate from and to
+						to = built.find_node(storage_.value(node));
+						from = built.node_end();
+					}
+					if (from == built.node_end() || built.value(from) != storage_.destination(e)) {
+						from = built.find_node(storage_.destination(e));
+					}
+					append_edge(built, from, to, storage_.weight(e));
+				}
+			}
+			return result;
+		}
+
 		// ########### Iterator access ###########
 		[[nodiscard]] auto begin() const -> iterator {
-			auto edge_list_begin_it = edges_.begin();
-			while (edge_list_begin_it != edges_.end() && edge_list_begin_it->second.empty()) {
-				++edge_list_begin_it;
-			}
-			if (edge_list_begin_it == edges_.end()) {
-				return iterator(edge_list_begin_it,
-				                edges_.begin(),
-				                edges_.end(),
-				                std::set<edge, edge_comparator>().cend());
+			auto const first = storage_.node_begin();
+			if (first == storage_.node_end()) {
+				return end();
 			}
-			return iterator(edge_list_begin_it,
-			                edges_.begin(),
-			                edges_.end(),
-			                edge_list_begin_it->second.begin());
+			return iterator(&storage_, first, storage_.edge_begin(first)).skip_empty_nodes();
 		}
 
 		[[nodiscard]] auto end() const -> iterator {
-			return iterator(edges_.end(),
-			                edges_.begin(),
-			                edges_.end(),
-			                std::set<edge, edge_comparator>().cend());
+			return iterator(&storage_, storage_.node_end(), edge_iterator());
 		}
 
 		// ########### Comparisons ###########
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
-			// compare nodes
-			auto is_equal = std::equal(
-			   nodes_.cbegin(),
-			   nodes_.cend(),
-			   other.nodes_.cbegin(),
-			   [](auto const& node, auto const& other_node) { return *node == *other_node; });
-
-			if (!is_equal) {
-				return false;
-			}
-
-			// compare edges
-			auto other_edge_list_it = other.edges_.cbegin();
-			for (auto edge_list_it = edges_.cbegin(); edge_list_it != edges_.cend(); ++edge_list_it) {
-				if (*(edge_list_it->first) != *(other_edge_list_it->first)
-				    || edge_list_it->second.size() != other_edge_list_it->second.size())
+			auto other_node = other.storage_.node_begin();
+			for (auto node = storage_.node_begin(); node != storage_.node_end(); ++node) {
+				if (other_node == other.storage_.node_end()
+				    || storage_.value(node) != other.storage_.value(other_node))
 				{
 					return false;
 				}
-				is_equal = std::equal(edge_list_it->second.cbegin(),
-				                      edge_list_it->second.cend(),
-				                      other_edge_list_it->second.begin(),
-				                      [](auto const& graph_edge, auto const& other_graph_edge) {
-					                      return *(graph_edge.to) == *(other_graph_edge.to)
-					                             && graph_edge.weight == other_graph_edge.weight;
-				                      });
-				if (!is_equal) {
+
+				auto e = storage_.edge_begin(node);
+				auto other_e = other.storage_.edge_begin(other_node);
+				for (; e != storage_.edge_end(node) && other_e != other.storage_.edge_end(other_node);
+				     ++e, ++other_e)
+				{
+					if (storage_.destination(e) != other.storage_.destination(other_e)
+					    || storage_.weight(e) != other.storage_.weight(other_e))
+					{
+						return false;
+					}
+				}
+				if (e != storage_.edge_end(node) || other_e != other.storage_.edge_end(other_node)) {
 					return false;
 				}
-				++other_edge_list_it;
+				++other_node;
 			}
-			return is_equal;
+			return other_node == other.storage_.node_end();
 		}
 
 		// ########### Extractor ###########
 		friend auto operator<<(std::ostream& ost, graph const& obj) -> std::ostream& {
-			for (auto edge_list_it = obj.edges_.cbegin(); edge_list_it != obj.edges_.cend();
-			     ++edge_list_it) {
-				ost << *(edge_list_it->first) << " (\n";
-				for (auto edge_it = edge_list_it->second.cbegin(); edge_it != edge_list_it->second.cend();
-				     ++edge_it)
-				{
-					ost << "  " << *edge_it->to << " | " << edge_it->weight << "\n";
+			auto const& storage = obj.storage_;
+			for (auto node = storage.node_begin(); node != storage.node_end(); ++node) {
+				ost << storage.value(node) << " (\n";
+				for (auto e = storage.edge_begin(node); e != storage.edge_end(node); ++e) {
+					if constexpr (weighted) {
+						ost << "  " << storage.destination(e) << " | " << storage.weight(e) << "\n";
+					}
+					else {
+						ost << "  " << storage.destination(e) << "\n";
+					}
 				}
 				ost << ")\n";
 			}
@@ -434,76 +480,194 @@ namespace gdwg {
 		}
 
 		// iterator: value_type
-		struct value_type {
-			N from;
-			N to;
-			E weight;
-		};
+		using value_type = detail::edge_value<N, E>;
+
+		// ########### Observers ###########
+		// Tells observer about every later change to this graph, until it unsubscribes or the
+		// graph is destroyed. Copies and moved-to graphs start with no observers.
+		auto subscribe(graph_observer<N, E>& observer) const -> void {
+			observers_.push_back(&observer);
+		}
+
+		auto unsubscribe(graph_observer<N, E>& observer) const -> void {
+			observers_.erase(std::remove(observers_.begin(), observers_.end(), &observer),
+			                 observers_.end());
+		}
 
 	private:
-		struct edge {
-			std::shared_ptr<N> to;
-			E weight;
-		};
+		storage_type storage_;
+		// not part of the graph's value, so subscribing is allowed on a const graph
+		mutable std::vector<graph_observer<N, E>*> observers_;
+
+		template<typename, typename>
+		friend class frozen_graph;
+
+		template<typename Src, typename Dst>
+		auto insert_edge_impl(Src const& src, Dst const& dst, weight_type const& weight) -> bool {
+			auto const src_it = find_node(src);
+			auto const dst_it = find_node(dst);
+			if (src_it == storage_.node_end() || dst_it == storage_.node_end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
+				                         "or dst node does not exist");
+			}
+			if (!storage_.insert_edge(src_it, dst_it, weight)) {
+				return false;
+			}
+			if (!observers_.empty()) {
+				auto const edge = make_value(storage_.value(src_it), storage_.value(dst_it), weight);
+				for (auto* const observer : observers_) {
+					observer->edge_inserted(edge);
+				}
+			}
+			return true;
+		}
 
-		struct node_comparator {
-			using is_transparent = void;
+		template<typename Src, typename Dst>
+		auto erase_edge_impl(Src const& src, Dst const& dst, weight_type const& weight) -> bool {
+			auto const src_it = find_node(src);
+			auto const dst_it = find_node(dst);
+			if (src_it == storage_.node_end() || dst_it == storage_.node_end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
+				                         "they don't exist in the graph");
+			}
 
-			auto operator()(std::shared_ptr<N> const& lhs, std::shared_ptr<N> const& rhs) const -> bool {
-				return *lhs < *rhs;
+			auto const edge_it = storage_.find_edge(src_it, dst_it, weight);
+			if (edge_it == storage_.edge_end(src_it)) {
+				return false;
 			}
 
-			auto operator()(std::shared_ptr<N> const& lhs, N const& rhs) const -> bool {
-				return *lhs < rhs;
+			storage_.erase_edge(src_it, edge_it);
+			if (!observers_.empty()) {
+				notify_edge_erased(make_value(storage_.value(src_it), storage_.value(dst_it), weight));
 			}
+			return true;
+		}
 
-			auto operator()(N const& lhs, std::shared_ptr<N> const& rhs) const -> bool {
-				return lhs < *rhs;
+		template<typename Src, typename Dst>
+		[[nodiscard]] auto find_impl(Src const& src, Dst const& dst, weight_type const& weight) const
+		   -> iterator {
+			auto const src_it = find_node(src);
+			auto const dst_it = find_node(dst);
+			if (src_it == storage_.node_end() || dst_it == storage_.node_end()) {
+				return end();
 			}
-		};
 
-		struct edge_comparator {
-			auto operator()(const edge& lhs, const edge& rhs) const -> bool {
-				if (*lhs.to == *rhs.to) {
-					return lhs.weight < rhs.weight;
-				}
-				return *lhs.to < *rhs.to;
+			auto const edge_it = storage_.find_edge(src_it, dst_it, weight);
+			if (edge_it == storage_.edge_end(src_it)) {
+				return end();
 			}
-		};
 
-		struct edge_list_comparator {
-			using is_transparent = void;
+			return iterator(&storage_, src_it, edge_it);
+		}
 
-			auto operator()(std::shared_ptr<N> const& lhs, std::shared_ptr<N> const& rhs) const -> bool {
-				return *lhs < *rhs;
+		// Looks key up through the storage, converting it to N only when the storage cannot take it.
+		template<typename K>
+		[[nodiscard]] auto find_node(K const& key) const -> node_iterator {
+			if constexpr (std::is_arithmetic_v<K> && std::is_integral_v<N> && !std::is_same_v<K, N>) {
+				// checked here rather than by each storage, which would compare, convert or truncate
+				// the key differently: a key N cannot hold exactly names no node
+				return detail::representable<N>(key) ? storage_.find_node(static_cast<N>(key))
+				                                      : storage_.node_end();
+			}
+			else if constexpr (requires { storage_.find_node(key); }) {
+				return storage_.find_node(key);
+			}
+			else {
+				return storage_.find_node(N(key));
 			}
+		}
+
+		auto swap(graph& other) -> void {
+			std::swap(storage_, other.storage_);
+		}
+
+		static constexpr auto offsets_by_value = std::is_integral_v<N> && !std::is_same_v<N, bool>;
+
+		// How far value is above lowest, computed unsigned so that it cannot overflow.
+		[[nodiscard]] static auto offset(N const& lowest, N const& value) -> std::size_t
+		requires offsets_by_value {
+			using unsigned_type = std::make_unsigned_t<N>;
+			return static_cast<std::size_t>(static_cast<unsigned_type>(value)
+			                                - static_cast<unsigned_type>(lowest));
+		}
 
-			auto operator()(std::shared_ptr<N> const& lhs, N const& rhs) const -> bool {
-				return *lhs < rhs;
+		// For ascending integral values spanning at most a few slots each, the rank of every value
+		// from the first to the last, with values.size() for those missing. Otherwise empty.
+		[[nodiscard]] static auto rank_table(std::vector<N> const& values)
+		   -> std::vector<std::size_t> {
+			if constexpr (offsets_by_value) {
+				constexpr auto slots_per_value = std::size_t{4};
+				if (!values.empty()
+				    && offset(values.front(), values.back()) / slots_per_value < values.size())
+				{
+					auto ranks = std::vector<std::size_t>(offset(values.front(), values.back()) + 1,
+					                                      values.size());
+					for (auto rank = std::size_t{0}; rank < values.size(); ++rank) {
+						ranks[offset(values.front(), values[rank])] = rank;
+					}
+					return ranks;
+				}
 			}
+			static_cast<void>(values);
+			return {};
+		}
 
-			auto operator()(N const& lhs, std::shared_ptr<N> const& rhs) const -> bool {
-				return lhs < *rhs;
+		// Adds value, greater than every node in storage, through append_node if it has one.
+		static auto append_node(storage_type& storage, N const& value) -> void {
+			if constexpr (requires { storage.append_node(value); }) {
+				storage.append_node(value);
 			}
+			else {
+				storage.insert_node(value);
+			}
+		}
+
+		static constexpr auto appends_edges =
+		   requires(storage_type& storage, node_iterator node, weight_type const& weight) {
+			storage.append_edge(node, node, weight);
 		};
 
-		std::set<std::shared_ptr<N>, node_comparator> nodes_;
-		std::map<std::shared_ptr<N>, std::set<edge, edge_comparator>, edge_list_comparator> edges_;
+		// Adds an edge ordered after every edge of src, through append_edge if storage has one.
+		static auto append_edge(storage_type& storage,
+		                        node_iterator src,
+		                        node_iterator dst,
+		                        weight_type const& weight) -> void {
+			if constexpr (appends_edges) {
+				storage.append_edge(src, dst, weight);
+			}
+			else {
+				storage.insert_edge(src, dst, weight);
+			}
+		}
 
-		auto swap(graph& other) -> void {
-			std::swap(nodes_, other.nodes_);
-			std::swap(edges_, other.edges_);
+		[[nodiscard]] static auto make_value(N const& from, N const& to, weight_type const& weight)
+		   -> value_type {
+			if constexpr (weighted) {
+				return value_type{from, to, weight};
+			}
+			else {
+				static_cast<void>(weight);
+				return value_type{from, to};
+			}
 		}
-	};
 
-	template<typename N, typename E>
-	class graph<N, E>::iterator {
-		using graph_const_iterator =
-		   typename std::map<std::shared_ptr<N>, std::set<edge, edge_comparator>, edge_list_comparator>::const_iterator;
-		using edge_const_iterator = typename std::set<edge, edge_comparator>::const_iterator;
+		auto notify_edge_erased(value_type const& edge) const -> void {
+			for (auto* const observer : observers_) {
+				observer->edge_erased(edge);
+			}
+		}
 
+		auto notify_changed() const noexcept -> void {
+			for (auto* const observer : observers_) {
+				observer->graph_changed();
+			}
+		}
+	};
+
+	template<typename N, typename E, typename Storage>
+	class graph<N, E, Storage>::iterator {
 	public:
-		using value_type = graph<N, E>::value_type;
+		using value_type = graph<N, E, Storage>::value_type;
 		using reference = value_type;
 		using pointer = void;
 		using difference_type = std::ptrdiff_t;
@@ -513,35 +677,27 @@ namespace gdwg {
 		iterator() = default;
 
 		// Iterator source
-		auto operator*() -> reference {
-			auto src = *(graph_it_->first);
-			auto dst = *(edge_it_->to);
-			auto weight = edge_it_->weight;
-			return value_type{src, dst, weight};
+		auto operator*() const -> reference {
+			if constexpr (weighted) {
+				return value_type{storage_->value(node_it_),
+				                  storage_->destination(edge_it_),
+				                  storage_->weight(edge_it_)};
+			}
+			else {
+				return value_type{storage_->value(node_it_), storage_->destination(edge_it_)};
+			}
 		}
 
 		// Iterator traversal
 		auto operator++() -> iterator& {
 			// end iterator
-			if (graph_it_ == graph_end_) {
+			if (at_end()) {
 				return *this;
 			}
 
-			// next iterator
+			// next edge, or the first edge of the next node that has one
 			++edge_it_;
-			if (edge_it_ == graph_it_->second.end()) {
-				// find next node
-				++graph_it_;
-				while (graph_it_ != graph_end_ && graph_it_->second.empty()) {
-					++graph_it_;
-				}
-
-				// find next edge
-				if (graph_it_ != graph_end_) {
-					edge_it_ = graph_it_->second.begin();
-				}
-			}
-			return *this;
+			return skip_empty_nodes();
 		}
 
 		auto operator++(int) -> iterator {
@@ -552,31 +708,23 @@ namespace gdwg {
 
 		auto operator--() -> iterator& {
 			// empty graph case
-			if (graph_begin_ == graph_end_) {
-				return *this;
-			}
-
-			// first iterator case
-			if (graph_it_ == graph_begin_ && edge_it_ == graph_begin_->second.begin()) {
+			if (storage_ == nullptr) {
 				return *this;
 			}
 
-			// find valid previous node
-			while (graph_it_ == graph_end_ || graph_it_->second.empty()) {
-				--graph_it_;
-				edge_it_ = graph_it_->second.end();
-			}
-
-			// previous edge
-			if (edge_it_ == graph_it_->second.begin()) {
-				--graph_it_;
-				while (graph_it_->second.empty()) {
-					--graph_it_;
+			// walk back over nodes without edges; the first edge has nothing before it
+			auto node = node_it_;
+			auto edge = edge_it_;
+			while (node == storage_->node_end() || edge == storage_->edge_begin(node)) {
+				if (node == storage_->node_begin()) {
+					return *this;
 				}
-				edge_it_ = graph_it_->second.end();
+				--node;
+				edge = storage_->edge_end(node);
 			}
-			--edge_it_;
 
+			node_it_ = node;
+			edge_it_ = --edge;
 			return *this;
 		}
 
@@ -588,48 +736,61 @@ namespace gdwg {
 
 		// Iterator comparison
 		auto operator==(iterator const& other) const -> bool {
-			if (graph_it_ == graph_end_) {
-				return other.graph_it_ == other.graph_end_;
+			if (at_end() || other.at_end()) {
+				return at_end() && other.at_end();
 			}
-			return graph_it_ == other.graph_it_ && edge_it_ == other.edge_it_;
+			return storage_ == other.storage_ && node_it_ == other.node_it_ && edge_it_ == other.edge_it_;
 		}
 
 	private:
-		explicit iterator(graph_const_iterator graph_it,
-		                  graph_const_iterator graph_begin,
-		                  graph_const_iterator graph_end,
-		                  edge_const_iterator edge_it)
-		: graph_it_(graph_it)
-		, graph_begin_(graph_begin)
-		, graph_end_(graph_end)
+		explicit iterator(storage_type const* storage, node_iterator node_it, edge_iterator edge_it)
+		: storage_(storage)
+		, node_it_(node_it)
 		, edge_it_(edge_it) {}
-		graph_const_iterator graph_it_;
-		graph_const_iterator graph_begin_;
-		graph_const_iterator graph_end_;
-		edge_const_iterator edge_it_;
+
+		storage_type const* storage_ = nullptr;
+		node_iterator node_it_;
+		edge_iterator edge_it_;
 		friend class graph;
+
+		[[nodiscard]] auto at_end() const -> bool {
+			return storage_ == nullptr || node_it_ == storage_->node_end();
+		}
+
+		// Moves past the end of the current node's edges to the next node that has any.
+		auto skip_empty_nodes() -> iterator& {
+			while (node_it_ != storage_->node_end() && edge_it_ == storage_->edge_end(node_it_)) {
+				++node_it_;
+				edge_it_ = node_it_ == storage_->node_end() ? edge_iterator()
+				                                            : storage_->edge_begin(node_it_);
+			}
+			return *this;
+		}
 	};
 
-	template<typename N, typename E>
-	auto graph<N, E>::erase_edge(iterator graph_it) -> iterator {
+	template<typename N, typename E, typename Storage>
+	auto graph<N, E, Storage>::erase_edge(iterator graph_it) -> iterator {
 		if (graph_it == end()) {
 			return end();
 		}
+		if (observers_.empty()) {
+			auto const next_edge = storage_.erase_edge(graph_it.node_it_, graph_it.edge_it_);
+			return iterator(&storage_, graph_it.node_it_, next_edge).skip_empty_nodes();
+		}
 
-		auto curr_graph_it = graph_it.graph_it_;
-		auto curr_edge_it = graph_it.edge_it_;
-		auto next_it = graph_it;
-		++next_it;
-
-		edges_[curr_graph_it->first].erase(curr_edge_it);
-
-		return next_it;
+		auto const erased = *graph_it;
+		auto const next_edge = storage_.erase_edge(graph_it.node_it_, graph_it.edge_it_);
+		auto const next = iterator(&storage_, graph_it.node_it_, next_edge).skip_empty_nodes();
+		notify_edge_erased(erased);
+		return next;
 	}
 
-	template<typename N, typename E>
-	auto graph<N, E>::erase_edge(iterator it_from, iterator it_to) -> iterator {
+	template<typename N, typename E, typename Storage>
+	auto graph<N, E, Storage>::erase_edge(iterator it_from, iterator it_to) -> iterator {
+		// count first: storages that keep edges contiguous shift it_to as edges before it go
+		auto count = std::distance(it_from, it_to);
 		auto g_it = it_from;
-		while (g_it != it_to) {
+		for (; count > 0; --count) {
 			g_it = erase_edge(g_it);
 		}
 		return g_it;
@@ -637,4 +798,32 @@ namespace gdwg {
 
 } // namespace gdwg
 
+// Explicitly instantiates (PREFIX empty) or declares (PREFIX extern) graph<N, E> with the default
+// storage, including the member templates for lookups by N itself.
+#define GDWG_GRAPH_INSTANTIATE(PREFIX, N, E)                                                     \
+	PREFIX template class gdwg::tree_storage::storage<N, E>;                                      \
+	PREFIX template class gdwg::graph<N, E>;                                                      \
+	PREFIX template auto gdwg::graph<N, E>::insert_edge<N, N>(N const&, N const&, E const&)       \
+	   -> bool;                                                                                   \
+	PREFIX template auto gdwg::graph<N, E>::erase_node<N>(N const&) -> bool;                      \
+	PREFIX template auto gdwg::graph<N, E>::erase_edge<N, N>(N const&, N const&, E const&)        \
+	   -> bool;                                                                                   \
+	PREFIX template auto gdwg::graph<N, E>::is_node<N>(N const&) const -> bool;                   \
+	PREFIX template auto gdwg::graph<N, E>::is_connected<N, N>(N const&, N const&) const -> bool; \
+	PREFIX template auto gdwg::graph<N, E>::weights<N, N>(N const&, N const&) const               \
+	   -> std::vector<E>;                                                                         \
+	PREFIX template auto gdwg::graph<N, E>::find<N, N>(N const&, N const&, E const&) const        \
+	   -> gdwg::graph<N, E>::iterator;                                                            \
+	PREFIX template auto gdwg::graph<N, E>::connections<N>(N const&) const -> std::vector<N>
+
+// The most common graphs are compiled once into the gdwg_graph library (source/graph.cpp), which
+// defines GDWG_GRAPH_EXTERN_TEMPLATES for everything that links against it. Those translation
+// units then use the library's instantiations instead of instantiating the graphs themselves.
+#ifdef GDWG_GRAPH_EXTERN_TEMPLATES
+#include <string>
+
+GDWG_GRAPH_INSTANTIATE(extern, std::string, int);
+GDWG_GRAPH_INSTANTIATE(extern, int, int);
+#endif // GDWG_GRAPH_EXTERN_TEMPLATES
+
 #endif // GDWG_GRAPH_HPP
@@ -0,0 +1,371 @@
+#ifndef GDWG_HEAP_HPP
+#define GDWG_HEAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Addressable min-heaps over the dense indices [0, capacity), used as priority queues by the
+// shortest-path algorithms. Like storage policies, a heap policy is a type with a nested
+// `heap<Key>` class template, which provides:
+//
+//     explicit heap(std::size_t capacity);
+//     auto empty() const -> bool;
+//     auto contains(std::size_t index) const -> bool;
+//     auto push(std::size_t index, Key key) -> void; // inserts index, or lowers its key
+//     auto pop() -> std::pair<std::size_t, Key>;     // removes an index with the smallest key
+//     auto clear() -> void;
+//
+// push never raises a key: pushing an index that is already queued with a key no greater than
+// the new one does nothing.
+namespace gdwg {
+	// A binary heap with a position table for decrease-key. A good default for any key type.
+	struct binary_heap {
+		template<typename Key>
+		class heap;
+	};
+
+	// A pairing heap. Decrease-key is O(1) amortised, which pays off on graphs where nodes are
+	// relaxed many times before they are settled.
+	struct pairing_heap {
+		template<typename Key>
+		class heap;
+	};
+
+	// A radix heap for non-negative integral keys. Each key moves through at most one bucket per
+	// bit, so operations are amortised O(log C) for keys up to C, independent of the number of
+	// queued indices. Keys must be monotone: nothing may be pushed below the last key popped,
+	// which Dijkstra's algorithm guarantees.
+	struct radix_heap {
+		template<typename Key>
+		class heap;
+	};
+
+	namespace detail {
+		inline constexpr auto no_index = std::numeric_limits<std::size_t>::max();
+	} // namespace detail
+
+	template<typename Key>
+	class binary_heap::heap {
+	public:
+		explicit heap(std::size_t capacity)
+		: keys_(capacity)
+		, position_(capacity, detail::no_index) {}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return heap_.empty();
+		}
+
+		[[nodiscard]] auto contains(std::size_t index) const -> bool {
+			return position_[index] != detail::no_index;
+		}
+
+		auto push(std::size_t index, Key key) -> void {
+			if (!contains(index)) {
+				position_[index] = heap_.size();
+				heap_.push_back(index);
+			}
+			else if (!(key < keys_[index])) {
+				return;
+			}
+			keys_[index] = key;
+			sift_up(position_[index]);
+		}
+
+		auto pop() -> std::pair<std::size_t, Key> {
+			auto const top = heap_.front();
+			position_[top] = detail::no_index;
+			heap_.front() = heap_.back();
+			heap_.pop_back();
+			if (!heap_.empty()) {
+				position_[heap_.front()] = 0;
+				sift_down(0);
+			}
+			return {top, keys_[top]};
+		}
+
+		auto clear() -> void {
+			for (auto const index : heap_) {
+				position_[index] = detail::no_index;
+			}
+			heap_.clear();
+		}
+
+	private:
+		std::vector<std::size_t> heap_;
+		std::vector<Key> keys_;
+		std::vector<std::size_t> position_;
+
+		auto sift_up(std::size_t slot) -> void {
+			auto const index = heap_[slot];
+			while (slot > 0) {
+				auto const parent = (slot - 1) / 2;
+				if (!(keys_[index] < keys_[heap_[parent]])) {
+					break;
+				}
+				place(slot, heap_[parent]);
+				slot = parent;
+			}
+			place(slot, index);
+		}
+
+		auto sift_down(std::size_t slot) -> void {
+			auto const index = heap_[slot];
+			for (auto child = 2 * slot + 1; child < heap_.size(); child = 2 * slot + 1) {
+				if (child + 1 < heap_.size() && keys_[heap_[child + 1]] < keys_[heap_[child]]) {
+					++child;
+				}
+				if (!(keys_[heap_[child]] < keys_[index])) {
+					break;
+				}
+				place(slot, heap_[child]);
+				slot = child;
+			}
+			place(slot, index);
+		}
+
+		auto place(std::size_t slot, std::size_t index) -> void {
+			heap_[slot] = index;
+			position_[index] = slot;
+		}
+	};
+
+	template<typename Key>
+	class pairing_heap::heap {
+	public:
+		explicit heap(std::size_t capacity)
+		: nodes_(capacity) {}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return root_ == detail::no_index;
+		}
+
+		[[nodiscard]] auto contains(std::size_t index) const -> bool {
+			return nodes_[index].queued;
+		}
+
+		auto push(std::size_t index, Key key) -> void {
+			auto& node = nodes_[index];
+			if (!node.queued) {
+				node = entry{key, detail::no_index, detail::no_index, detail::no_index, true};
+				root_ = meld(root_, index);
+				return;
+			}
+			if (!(key < node.key)) {
+				return;
+			}
+			node.key = key;
+			if (index != root_) {
+				detach(index);
+				root_ = meld(root_, index);
+			}
+		}
+
+		auto pop() -> std::pair<std::size_t, Key> {
+			auto const top = root_;
+			nodes_[top].queued = false;
+			root_ = merge_pairs(nodes_[top].child);
+			if (root_ != detail::no_index) {
+				nodes_[root_].prev = detail::no_index;
+			}
+			return {top, nodes_[top].key};
+		}
+
+		auto clear() -> void {
+			for (auto& node : nodes_) {
+				node.queued = false;
+			}
+			root_ = detail::no_index;
+		}
+
+	private:
+		// prev is the left sibling, or the parent for a leftmost child.
+		struct entry {
+			Key key{};
+			std::size_t child = detail::no_index;
+			std::size_t sibling = detail::no_index;
+			std::size_t prev = detail::no_index;
+			bool queued = false;
+		};
+
+		std::vector<entry> nodes_;
+		std::vector<std::size_t> pairs_;
+		std::size_t root_ = detail::no_index;
+
+		// Links two roots, making the one with the larger key the leftmost child of the other.
+		auto meld(std::size_t a, std::size_t b) -> std::size_t {
+			if (a == detail::no_index) {
+				return b;
+			}
+			if (b == detail::no_index) {
+				return a;
+			}
+			if (nodes_[b].key < nodes_[a].key) {
+				std::swap(a, b);
+			}
+			auto& parent = nodes_[a];
+			auto& child = nodes_[b];
+			child.prev = a;
+			child.sibling = parent.child;
+			if (parent.child != detail::no_index) {
+				nodes_[parent.child].prev = b;
+			}
+			parent.child = b;
+			parent.sibling = detail::no_index;
+			return a;
+		}
+
+		// Cuts index and its subtree out of its parent's child list.
+		auto detach(std::size_t index) -> void {
+			auto& node = nodes_[index];
+			auto& prev = nodes_[node.prev];
+			if (prev.child == index) {
+				prev.child = node.sibling;
+			}
+			else {
+				prev.sibling = node.sibling;
+			}
+			if (node.sibling != detail::no_index) {
+				nodes_[node.sibling].prev = node.prev;
+			}
+			node.sibling = detail::no_index;
+			node.prev = detail::no_index;
+		}
+
+		// The standard two-pass merge: meld siblings pairwise left to right, then fold the pairs
+		// together right to left.
+		auto merge_pairs(std::size_t first) -> std::size_t {
+			pairs_.clear();
+			while (first != detail::no_index) {
+				auto const second = nodes_[first].sibling;
+				auto const rest =
+				   second == detail::no_index ? detail::no_index : nodes_[second].sibling;
+				nodes_[first].sibling = detail::no_index;
+				if (second != detail::no_index) {
+					nodes_[second].sibling = detail::no_index;
+				}
+				pairs_.push_back(meld(first, second));
+				first = rest;
+			}
+
+			auto result = detail::no_index;
+			for (auto it = pairs_.rbegin(); it != pairs_.rend(); ++it) {
+				result = meld(*it, result);
+			}
+			return result;
+		}
+	};
+
+	template<typename Key>
+	class radix_heap::heap {
+		static_assert(std::is_integral_v<Key>, "gdwg::radix_heap requires an integral key");
+
+		using bits_type = std::make_unsigned_t<Key>;
+		static constexpr auto bucket_count =
+		   static_cast<std::size_t>(std::numeric_limits<bits_type>::digits) + 1;
+
+	public:
+		explicit heap(std::size_t capacity)
+		: keys_(capacity)
+		, queued_(capacity, false) {}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size_ == 0;
+		}
+
+		[[nodiscard]] auto contains(std::size_t index) const -> bool {
+			return queued_[index];
+		}
+
+		// A lowered key leaves its old entry behind; pop skips entries that are out of date.
+		auto push(std::size_t index, Key key) -> void {
+			auto const bits = static_cast<bits_type>(key);
+			if (queued_[index] && !(bits < keys_[index])) {
+				return;
+			}
+			if (!queued_[index]) {
+				queued_[index] = true;
+				++size_;
+			}
+			keys_[index] = bits;
+			buckets_[bucket(bits)].emplace_back(bits, index);
+		}
+
+		auto pop() -> std::pair<std::size_t, Key> {
+			for (;;) {
+				if (buckets_[0].empty()) {
+					redistribute();
+				}
+				auto const [bits, index] = buckets_[0].back();
+				buckets_[0].pop_back();
+				if (is_current(bits, index)) {
+					queued_[index] = false;
+					--size_;
+					return {index, static_cast<Key>(bits)};
+				}
+			}
+		}
+
+		auto clear() -> void {
+			for (auto& bucket : buckets_) {
+				for (auto const& [bits, index] : bucket) {
+					queued_[index] = false;
+				}
+				bucket.clear();
+			}
+			size_ = 0;
+			last_ = 0;
+		}
+
+	private:
+		std::vector<std::pair<bits_type, std::size_t>> buckets_[bucket_count];
+		std::vector<std::pair<bits_type, std::size_t>> scratch_;
+		std::vector<bits_type> keys_;
+		std::vector<bool> queued_;
+		std::size_t size_ = 0;
+		bits_type last_ = 0;
+
+		// Keys equal to last_ go in bucket 0; others by the highest bit in which they differ.
+		[[nodiscard]] auto bucket(bits_type bits) const -> std::size_t {
+			return static_cast<std::size_t>(std::bit_width(static_cast<bits_type>(bits ^ last_)));
+		}
+
+		[[nodiscard]] auto is_current(bits_type bits, std::size_t index) const -> bool {
+			return queued_[index] && keys_[index] == bits;
+		}
+
+		// Empties the first non-empty bucket into lower ones around its smallest current key.
+		auto redistribute() -> void {
+			for (auto b = std::size_t{1}; b < bucket_count; ++b) {
+				auto& source = buckets_[b];
+				auto smallest = std::numeric_limits<bits_type>::max();
+				auto found = false;
+				for (auto const& [bits, index] : source) {
+					if (is_current(bits, index) && (!found || bits < smallest)) {
+						smallest = bits;
+						found = true;
+					}
+				}
+				if (!found) {
+					source.clear();
+					continue;
+				}
+
+				last_ = smallest;
+				std::swap(source, scratch_);
+				for (auto const& [bits, index] : scratch_) {
+					if (is_current(bits, index)) {
+						buckets_[bucket(bits)].emplace_back(bits, index);
+					}
+				}
+				scratch_.clear();
+				return;
+			}
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_HEAP_HPP
@@ -0,0 +1,236 @@
+#ifndef GDWG_K_SHORTEST_PATHS_HPP
+#define GDWG_K_SHORTEST_PATHS_HPP
+
+#include <gdwg/astar.hpp>
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/heap.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A path by node rank, source first, with its total weight.
+	template<typename W>
+	struct weighted_path {
+		W length;
+		std::vector<std::size_t> nodes;
+	};
+
+	namespace detail {
+		// Shortest paths to one target in a graph with some nodes and edges masked out, reusing
+		// its arrays from one search to the next and resetting only what each search touched.
+		// Masking only lengthens distances, so the unmasked distances to the target are a
+		// consistent A* heuristic for every search.
+		template<typename N, typename E>
+		class masked_search {
+		public:
+			masked_search(frozen_graph<N, E> const& g, std::size_t target)
+			: g_(&g)
+			, target_(target)
+			, remaining_(distances_to(g, target))
+			, masked_node_(g.size())
+			, masked_edge_(g.edge_count())
+			, distance_(g.size(), unreachable<E>)
+			, predecessor_(g.size(), no_rank)
+			, queue_(g.size()) {}
+
+			// The unmasked distance from rank to the target.
+			[[nodiscard]] auto remaining(std::size_t rank) const -> E {
+				return remaining_[rank];
+			}
+
+			auto mask_node(std::size_t rank) -> void {
+				masked_node_[rank] = 1;
+				masked_nodes_.push_back(rank);
+			}
+
+			// Masks every edge from -> to.
+			auto mask_edges(std::size_t from, std::size_t to) -> void {
+				auto const neighbours = g_->out_neighbours(from);
+				auto const [first, last] = std::equal_range(neighbours.begin(), neighbours.end(), to);
+				for (auto it = first; it != last; ++it) {
+					auto const edge = g_->first_out_edge(from)
+					                  + static_cast<std::size_t>(it - neighbours.begin());
+					masked_edge_[edge] = 1;
+					masked_edges_.push_back(edge);
+				}
+			}
+
+			auto unmask() -> void {
+				for (auto const rank : masked_nodes_) {
+					masked_node_[rank] = 0;
+				}
+				for (auto const edge : masked_edges_) {
+					masked_edge_[edge] = 0;
+				}
+				masked_nodes_.clear();
+				masked_edges_.clear();
+			}
+
+			// A shortest path from source to the target avoiding everything masked, appended to
+			// path after source itself, and its length; unreachable<E> if there is none.
+			auto search(std::size_t source, std::vector<std::size_t>& path) -> E {
+				if (remaining_[source] == unreachable<E>) {
+					return unreachable<E>;
+				}
+				distance_[source] = E{};
+				touched_.push_back(source);
+				queue_.push(source, remaining_[source]);
+				while (!queue_.empty()) {
+					auto const from = queue_.pop().first;
+					if (from == target_) {
+						break;
+					}
+					auto const neighbours = g_->out_neighbours(from);
+					auto const weights = g_->out_weights(from);
+					auto const first = g_->first_out_edge(from);
+					for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+						auto const to = neighbours[i];
+						if (masked_edge_[first + i] || masked_node_[to]
+						    || remaining_[to] == unreachable<E>)
+						{
+							continue;
+						}
+						auto const candidate = saturating_add(distance_[from], weights[i]);
+						if (candidate < distance_[to]) {
+							if (distance_[to] == unreachable<E>) {
+								touched_.push_back(to);
+							}
+							distance_[to] = candidate;
+							predecessor_[to] = from;
+							queue_.push(to, saturating_add(candidate, remaining_[to]));
+						}
+					}
+				}
+
+				auto const length = distance_[target_];
+				if (length != unreachable<E>) {
+					auto const start = path.size();
+					for (auto rank = target_; rank != source; rank = predecessor_[rank]) {
+						path.push_back(rank);
+					}
+					std::reverse(path.begin() + static_cast<std::ptrdiff_t>(start), path.end());
+				}
+				for (auto const rank : touched_) {
+					distance_[rank] = unreachable<E>;
+					predecessor_[rank] = no_rank;
+				}
+				touched_.clear();
+				queue_.clear();
+				return length;
+			}
+
+		private:
+			frozen_graph<N, E> const* g_;
+			std::size_t target_;
+			std::vector<E> remaining_;
+			std::vector<char> masked_node_;
+			std::vector<char> masked_edge_;
+			std::vector<std::size_t> masked_nodes_;
+			std::vector<std::size_t> masked_edges_;
+			std::vector<E> distance_;
+			std::vector<std::size_t> predecessor_;
+			std::vector<std::size_t> touched_;
+			binary_heap::heap<E> queue_;
+		};
+
+		// The weight of the lightest edge from -> to.
+		template<typename N, typename E>
+		auto lightest_edge(frozen_graph<N, E> const& g, std::size_t from, std::size_t to) -> E {
+			auto const neighbours = g.out_neighbours(from);
+			auto const weights = g.out_weights(from);
+			auto const first = std::lower_bound(neighbours.begin(), neighbours.end(), to);
+			auto const offset = first - neighbours.begin();
+			auto const count = std::upper_bound(first, neighbours.end(), to) - first;
+			return *std::min_element(weights.begin() + offset, weights.begin() + offset + count);
+		}
+	} // namespace detail
+
+	// Up to k shortest loopless paths from src to dst, shortest first, by Yen's algorithm. Fewer
+	// are returned if fewer exist. Paths are sequences of nodes, so parallel edges count once, by
+	// their lightest.
+	//
+	// Each spur search runs on the one frozen graph with the root path's nodes and the next
+	// edges of paths sharing that root masked out, instead of on a copy with them erased. The
+	// distances to dst over the whole graph are computed once and steer every spur search as an
+	// A* heuristic, which also skips at once any node that cannot reach dst at all.
+	template<typename N, typename E, node_key<N> Src, node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto k_shortest_paths(frozen_graph<N, E> const& g,
+	                      Src const& src,
+	                      Dst const& dst,
+	                      std::size_t k) -> std::vector<weighted_path<E>> {
+		auto const source = g.rank(src);
+		auto const target = g.rank(dst);
+		if (source == no_rank || target == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::k_shortest_paths if src or dst node don't "
+			                         "exist in the graph");
+		}
+		if (g.edge_count() > 0 && g.min_weight() < E{}) {
+			throw std::runtime_error("Cannot call gdwg::k_shortest_paths on a graph with negative "
+			                         "edge weights");
+		}
+
+		auto result = std::vector<weighted_path<E>>{};
+		auto search = detail::masked_search<N, E>(g, target);
+		if (k == 0 || search.remaining(source) == unreachable<E>) {
+			return result;
+		}
+		auto first = weighted_path<E>{E{}, {source}};
+		first.length = search.search(source, first.nodes);
+		result.push_back(std::move(first));
+
+		// ordered by length then nodes, which also drops a candidate found twice
+		auto candidates = std::set<std::pair<E, std::vector<std::size_t>>>{};
+		while (result.size() < k) {
+			auto const& last = result.back().nodes;
+			auto root_length = E{};
+			for (auto spur = std::size_t{0}; spur + 1 < last.size(); ++spur) {
+				auto const root_end = last.begin() + static_cast<std::ptrdiff_t>(spur + 1);
+				for (auto const& found : result) {
+					if (found.nodes.size() > spur + 1
+					    && std::equal(last.begin(), root_end, found.nodes.begin()))
+					{
+						search.mask_edges(found.nodes[spur], found.nodes[spur + 1]);
+					}
+				}
+				for (auto i = std::size_t{0}; i < spur; ++i) {
+					search.mask_node(last[i]);
+				}
+
+				auto path = std::vector<std::size_t>(last.begin(), root_end);
+				auto const spur_length = search.search(last[spur], path);
+				auto const length = detail::saturating_add(root_length, spur_length);
+				if (length != unreachable<E>) {
+					candidates.emplace(length, std::move(path));
+				}
+				search.unmask();
+				root_length += detail::lightest_edge(g, last[spur], last[spur + 1]);
+			}
+
+			if (candidates.empty()) {
+				break;
+			}
+			auto next = candidates.extract(candidates.begin());
+			result.push_back({next.value().first, std::move(next.value().second)});
+		}
+		return result;
+	}
+
+	template<typename N, typename E, typename Storage, node_key<N> Src, node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto k_shortest_paths(graph<N, E, Storage> const& g,
+	                      Src const& src,
+	                      Dst const& dst,
+	                      std::size_t k) -> std::vector<weighted_path<E>> {
+		return k_shortest_paths(frozen_graph<N, E>(g), src, dst, k);
+	}
+} // namespace gdwg
+
+#endif // GDWG_K_SHORTEST_PATHS_HPP
@@ -0,0 +1,185 @@
+#ifndef GDWG_NEIGHBOURHOOD_HPP
+#define GDWG_NEIGHBOURHOOD_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Neighbourhood overlap. These treat the graph as undirected and simple: two nodes are neighbours
+// if an edge runs either way between them, however many there are, and self-loops are ignored.
+namespace gdwg {
+	namespace detail {
+		// Calls fn(neighbour) for each neighbour of rank in ascending order, merging its out- and
+		// in-neighbours.
+		template<typename N, typename E, typename F>
+		auto for_each_neighbour(frozen_graph<N, E> const& g, std::size_t rank, F&& fn) -> void {
+			auto const out = g.out_neighbours(rank);
+			auto const in = g.in_neighbours(rank);
+			auto i = std::size_t{0};
+			auto j = std::size_t{0};
+			auto last = rank;
+			while (i < out.size() || j < in.size()) {
+				auto const next = j == in.size() || (i < out.size() && out[i] < in[j]) ? out[i++]
+				                                                                        : in[j++];
+				if (next != last && next != rank) {
+					fn(next);
+					last = next;
+				}
+			}
+		}
+
+		// Calls fn(value) for each value in both sorted ranges. When one range is much shorter,
+		// each of its values is found in the other by galloping; otherwise the two are merged
+		// with a loop whose only branch is the loop test, so it pipelines (and vectorises where
+		// the target can) well.
+		template<typename F>
+		auto intersect(std::span<std::size_t const> lhs, std::span<std::size_t const> rhs, F&& fn)
+		   -> void {
+			constexpr auto gallop_ratio = std::size_t{16};
+			if (lhs.size() > rhs.size()) {
+				std::swap(lhs, rhs);
+			}
+			if (lhs.size() * gallop_ratio < rhs.size()) {
+				auto first = rhs.begin();
+				for (auto const value : lhs) {
+					// everything before low is less than value, and high is the end or not less
+					auto low = first;
+					auto high = first;
+					for (auto step = std::ptrdiff_t{1}; high != rhs.end() && *high < value; step *= 2) {
+						low = high + 1;
+						high = rhs.end() - high > step ? high + step : rhs.end();
+					}
+					first = std::lower_bound(low, high, value);
+					if (first == rhs.end()) {
+						return;
+					}
+					if (*first == value) {
+						fn(value);
+					}
+				}
+				return;
+			}
+
+			auto i = std::size_t{0};
+			auto j = std::size_t{0};
+			while (i < lhs.size() && j < rhs.size()) {
+				auto const x = lhs[i];
+				auto const y = rhs[j];
+				if (x == y) {
+					fn(x);
+				}
+				i += static_cast<std::size_t>(x <= y);
+				j += static_cast<std::size_t>(y <= x);
+			}
+		}
+
+		template<typename N, typename E>
+		auto neighbours(frozen_graph<N, E> const& g, std::size_t rank) -> std::vector<std::size_t> {
+			auto result = std::vector<std::size_t>{};
+			for_each_neighbour(g, rank, [&](std::size_t next) { result.push_back(next); });
+			return result;
+		}
+	} // namespace detail
+
+	// The number of triangles: sets of three nodes that are all neighbours of each other.
+	//
+	// Each neighbour pair is kept once, oriented from the endpoint of lower degree (ties broken
+	// by rank) into a contiguous sorted array, so no node keeps more than O(sqrt(E)) higher
+	// neighbours. Each triangle is then found exactly once, by intersecting the arrays at the
+	// ends of its lowest edge, in parallel across pool by node.
+	template<typename N, typename E>
+	auto count_triangles(frozen_graph<N, E> const& g, thread_pool& pool = default_thread_pool())
+	   -> std::size_t {
+		auto const size = g.size();
+		auto degree = std::vector<std::size_t>(size);
+		pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+			detail::for_each_neighbour(g, rank, [&](std::size_t) { ++degree[rank]; });
+		});
+		auto const lower = [&](std::size_t lhs, std::size_t rhs) {
+			return degree[lhs] < degree[rhs] || (degree[lhs] == degree[rhs] && lhs < rhs);
+		};
+
+		auto offset = std::vector<std::size_t>(size + 1);
+		pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+			detail::for_each_neighbour(g, rank, [&](std::size_t next) {
+				offset[rank + 1] += static_cast<std::size_t>(lower(rank, next));
+			});
+		});
+		std::partial_sum(offset.begin(), offset.end(), offset.begin());
+		auto higher = std::vector<std::size_t>(offset[size]);
+		pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+			auto out = higher.begin() + static_cast<std::ptrdiff_t>(offset[rank]);
+			detail::for_each_neighbour(g, rank, [&](std::size_t next) {
+				if (lower(rank, next)) {
+					*out++ = next;
+				}
+			});
+		});
+
+		auto const higher_than = [&](std::size_t rank) {
+			return std::span<std::size_t const>(higher).subspan(offset[rank],
+			                                                    offset[rank + 1] - offset[rank]);
+		};
+		auto counts = std::vector<std::size_t>(pool.size());
+		pool.for_each_chunk(
+		   size,
+		   pool.default_grain(size),
+		   [&](std::size_t first, std::size_t last, std::size_t thread) {
+			   auto count = std::size_t{0};
+			   auto const tally = [&count](std::size_t) { ++count; };
+			   for (auto rank = first; rank < last; ++rank) {
+				   auto const mine = higher_than(rank);
+				   for (auto const next : mine) {
+					   detail::intersect(mine, higher_than(next), tally);
+				   }
+			   }
+			   counts[thread] += count;
+		   });
+		return std::accumulate(counts.begin(), counts.end(), std::size_t{0});
+	}
+
+	template<typename N, typename E, typename Storage>
+	auto count_triangles(graph<N, E, Storage> const& g, thread_pool& pool = default_thread_pool())
+	   -> std::size_t {
+		return count_triangles(frozen_graph<N, E>(g), pool);
+	}
+
+	// The ranks of the nodes that are neighbours of both a and b, ascending.
+	template<typename N, typename E, node_key<N> A, node_key<N> B>
+	auto common_neighbours(frozen_graph<N, E> const& g, A const& a, B const& b)
+	   -> std::vector<std::size_t> {
+		auto const lhs = g.rank(a);
+		auto const rhs = g.rank(b);
+		if (lhs == no_rank || rhs == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::common_neighbours if a or b node don't exist "
+			                         "in the graph");
+		}
+		auto result = std::vector<std::size_t>{};
+		detail::intersect(detail::neighbours(g, lhs),
+		                  detail::neighbours(g, rhs),
+		                  [&](std::size_t rank) { result.push_back(rank); });
+		return result;
+	}
+
+	// The nodes that are neighbours of both a and b, ascending. This freezes g first; freeze it
+	// once instead when asking about many pairs.
+	template<typename N, typename E, typename Storage, node_key<N> A, node_key<N> B>
+	auto common_neighbours(graph<N, E, Storage> const& g, A const& a, B const& b) -> std::vector<N> {
+		auto const frozen = frozen_graph<N, E>(g);
+		auto result = std::vector<N>{};
+		for (auto const rank : common_neighbours(frozen, a, b)) {
+			result.push_back(frozen.node(rank));
+		}
+		return result;
+	}
+} // namespace gdwg
+
+#endif // GDWG_NEIGHBOURHOOD_HPP
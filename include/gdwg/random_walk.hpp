@@ -0,0 +1,287 @@
+#ifndef GDWG_RANDOM_WALK_HPP
+#define GDWG_RANDOM_WALK_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	// Walks of a fixed number of nodes each, by rank, laid out one after another.
+	struct random_walks {
+		std::size_t length;
+		// count() * length ranks. A walk that reaches a node it cannot leave is padded with
+		// no_rank from there on.
+		std::vector<std::size_t> nodes;
+
+		[[nodiscard]] auto count() const noexcept -> std::size_t {
+			return length == 0 ? 0 : nodes.size() / length;
+		}
+
+		[[nodiscard]] auto operator[](std::size_t walk) const -> std::span<std::size_t const> {
+			return std::span(nodes).subspan(walk * length, length);
+		}
+	};
+
+	namespace detail {
+		// SplitMix64: a 64-bit generator whose whole state is one counter, so seeding a fresh one
+		// for every walk costs nothing.
+		class walk_engine {
+		public:
+			using result_type = std::uint64_t;
+
+			explicit walk_engine(std::uint64_t seed) noexcept
+			: state_(seed) {}
+
+			[[nodiscard]] static constexpr auto min() noexcept -> result_type {
+				return 0;
+			}
+
+			[[nodiscard]] static constexpr auto max() noexcept -> result_type {
+				return std::numeric_limits<result_type>::max();
+			}
+
+			auto operator()() noexcept -> result_type {
+				auto z = state_ += 0x9e3779b97f4a7c15;
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+				return z ^ (z >> 31);
+			}
+
+		private:
+			std::uint64_t state_;
+		};
+
+		// The stream of the walk-th walk from seed, starting at a scrambled point of the sequence
+		// so that neighbouring walks do not share draws. The seed is scrambled on its own first:
+		// adding the walk to it directly would make walk w + 1 of seed s walk w of seed s + 1.
+		inline auto walk_stream(std::uint64_t seed, std::size_t walk) noexcept -> walk_engine {
+			auto const scrambled_seed = walk_engine(seed)();
+			return walk_engine(walk_engine(scrambled_seed + static_cast<std::uint64_t>(walk))());
+		}
+	} // namespace detail
+
+	// Weighted random walks, each step following an out-edge with probability proportional to its
+	// weight. Every edge of a graph<N, void> weighs one. Edges weighing zero are never followed,
+	// so a node without out-edges of positive weight ends the walk.
+	//
+	// Each node's out-edges get an alias table (Walker, as built by Vose), so a step costs one
+	// random number and at most two lookups, however many edges the node has. The tables are
+	// flat arrays built in parallel across pool; the sampler keeps no reference to the graph.
+	class walk_sampler {
+	public:
+		template<typename N, typename E>
+		requires std::is_void_v<E> || std::is_arithmetic_v<E>
+		explicit walk_sampler(frozen_graph<N, E> const& g, thread_pool& pool = default_thread_pool())
+		: first_(g.size() + 1) {
+			if constexpr (!std::is_void_v<E>) {
+				if (g.edge_count() > 0 && g.min_weight() < E{}) {
+					throw std::runtime_error("Cannot call gdwg::walk_sampler on a graph with negative "
+					                         "edge weights");
+				}
+			}
+			auto const size = g.size();
+			auto const followed = [&g](std::size_t edge) {
+				if constexpr (std::is_void_v<E>) {
+					static_cast<void>(g);
+					static_cast<void>(edge);
+					return 1.0;
+				}
+				else {
+					return static_cast<double>(g.weight(edge));
+				}
+			};
+
+			pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+				auto const first = g.first_out_edge(rank);
+				auto count = std::size_t{0};
+				for (auto edge = first; edge < first + g.out_degree(rank); ++edge) {
+					if (followed(edge) > 0.0) {
+						++count;
+					}
+				}
+				first_[rank + 1] = count;
+			});
+			for (auto rank = std::size_t{0}; rank < size; ++rank) {
+				first_[rank + 1] += first_[rank];
+			}
+			target_.resize(first_[size]);
+			alias_.resize(first_[size]);
+			keep_.resize(first_[size]);
+
+			pool.for_each_chunk(
+			   size,
+			   pool.default_grain(size),
+			   [&](std::size_t first, std::size_t last, std::size_t) {
+				   auto small = std::vector<std::size_t>{};
+				   auto large = std::vector<std::size_t>{};
+				   for (auto rank = first; rank < last; ++rank) {
+					   auto const neighbours = g.out_neighbours(rank);
+					   auto slot = first_[rank];
+					   auto total = 0.0;
+					   for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+						   auto const weight = followed(g.first_out_edge(rank) + i);
+						   if (weight > 0.0) {
+							   target_[slot] = neighbours[i];
+							   keep_[slot] = weight;
+							   total += weight;
+							   ++slot;
+						   }
+					   }
+					   build_alias_table(first_[rank], first_[rank + 1], total, small, large);
+				   }
+			   });
+		}
+
+		template<typename N, typename E, typename Storage>
+		requires std::is_void_v<E> || std::is_arithmetic_v<E>
+		explicit walk_sampler(graph<N, E, Storage> const& g,
+		                      thread_pool& pool = default_thread_pool())
+		: walk_sampler(frozen_graph<N, E>(g), pool) {}
+
+		// The number of nodes in the graph the sampler was built for.
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return first_.size() - 1;
+		}
+
+		// The rank of the node one step on from the node of rank from, or no_rank if the walk
+		// cannot leave it.
+		template<std::uniform_random_bit_generator G>
+		[[nodiscard]] auto step(std::size_t from, G& engine) const -> std::size_t {
+			auto const first = first_[from];
+			auto const count = first_[from + 1] - first;
+			if (count == 0) {
+				return no_rank;
+			}
+			// one draw picks both the slot, by its integral part, and the coin, by the rest
+			constexpr auto below_one = 1.0 - std::numeric_limits<double>::epsilon() / 2;
+			auto const draw =
+			   std::min(std::generate_canonical<double, std::numeric_limits<double>::digits>(engine),
+			            below_one);
+			auto const scaled = draw * static_cast<double>(count);
+			auto const slot = std::min(static_cast<std::size_t>(scaled), count - 1);
+			auto const coin = scaled - static_cast<double>(slot);
+			return coin < keep_[first + slot] ? target_[first + slot] : alias_[first + slot];
+		}
+
+		// One walk of length nodes from each of the nodes of rank starts, in order.
+		//
+		// Every walk draws from its own random stream, derived from seed and the walk's index, so
+		// the walks depend only on seed and not on the size of pool or how the work is split.
+		[[nodiscard]] auto walks(std::vector<std::size_t> const& starts,
+		                         std::size_t length,
+		                         std::uint64_t seed,
+		                         thread_pool& pool = default_thread_pool()) const -> random_walks {
+			auto const outside = [this](std::size_t rank) { return rank >= size(); };
+			if (std::any_of(starts.begin(), starts.end(), outside)) {
+				throw std::runtime_error("Cannot call gdwg::walk_sampler::walks with a start node that "
+				                         "doesn't exist in the graph");
+			}
+			return generate(
+			   starts.size(),
+			   [&starts](std::size_t walk) { return starts[walk]; },
+			   length,
+			   seed,
+			   pool);
+		}
+
+		// per_node walks of length nodes from every node, the walk-th starting from the node of
+		// rank walk % size(), with the same streams as walks.
+		[[nodiscard]] auto walks_from_each_node(std::size_t per_node,
+		                                        std::size_t length,
+		                                        std::uint64_t seed,
+		                                        thread_pool& pool = default_thread_pool()) const
+		   -> random_walks {
+			auto const nodes = size();
+			return generate(
+			   per_node * nodes,
+			   [nodes](std::size_t walk) { return walk % nodes; },
+			   length,
+			   seed,
+			   pool);
+		}
+
+	private:
+		// first_[rank] .. first_[rank + 1] are the slots of rank's edges of positive weight. Slot i
+		// keeps its own target_ with probability keep_[i] and otherwise takes alias_[i].
+		std::vector<std::size_t> first_;
+		std::vector<std::size_t> target_;
+		std::vector<std::size_t> alias_;
+		std::vector<double> keep_;
+
+		// Turns the weights in keep_[first, last), summing to total, into an alias table by
+		// pairing each slot below the mean with one above it, which tops it up.
+		auto build_alias_table(std::size_t first,
+		                       std::size_t last,
+		                       double total,
+		                       std::vector<std::size_t>& small,
+		                       std::vector<std::size_t>& large) -> void {
+			auto const count = static_cast<double>(last - first);
+			for (auto slot = first; slot < last; ++slot) {
+				keep_[slot] = keep_[slot] * count / total;
+				alias_[slot] = target_[slot];
+				(keep_[slot] < 1.0 ? small : large).push_back(slot);
+			}
+			while (!small.empty() && !large.empty()) {
+				auto const under = small.back();
+				small.pop_back();
+				auto const over = large.back();
+				alias_[under] = target_[over];
+				keep_[over] -= 1.0 - keep_[under];
+				if (keep_[over] < 1.0) {
+					large.pop_back();
+					small.push_back(over);
+				}
+			}
+			// whatever is left is within rounding error of the mean
+			for (auto const slot : small) {
+				keep_[slot] = 1.0;
+			}
+			for (auto const slot : large) {
+				keep_[slot] = 1.0;
+			}
+			small.clear();
+			large.clear();
+		}
+
+		template<typename Start>
+		auto generate(std::size_t count,
+		              Start start,
+		              std::size_t length,
+		              std::uint64_t seed,
+		              thread_pool& pool) const -> random_walks {
+			auto result = random_walks{length, std::vector<std::size_t>(count * length, no_rank)};
+			if (length == 0) {
+				return result;
+			}
+			pool.for_each_chunk(
+			   count,
+			   pool.default_grain(count),
+			   [&](std::size_t first, std::size_t last, std::size_t) {
+				   for (auto walk = first; walk < last; ++walk) {
+					   auto engine = detail::walk_stream(seed, walk);
+					   auto* const out = result.nodes.data() + walk * length;
+					   out[0] = start(walk);
+					   for (auto i = std::size_t{1}; i < length; ++i) {
+						   out[i] = step(out[i - 1], engine);
+						   if (out[i] == no_rank) {
+							   break;
+						   }
+					   }
+				   }
+			   });
+			return result;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_RANDOM_WALK_HPP
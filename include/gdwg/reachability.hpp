@@ -0,0 +1,229 @@
+#ifndef GDWG_REACHABILITY_HPP
+#define GDWG_REACHABILITY_HPP
+
+#include <gdwg/components.hpp>
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace gdwg {
+	// Answers whether one node can reach another along the edges of a gdwg::graph, in
+	// O(log V) for the node lookups and O(1) for the answer.
+	//
+	// The graph is condensed into its strongly connected components, and each component keeps a
+	// bitset of the components it reaches, so memory grows with the square of the number of
+	// components. The index subscribes to the graph and repairs itself where it can: new nodes
+	// get a component of their own, an edge that does not close a cycle ORs its destination's
+	// reach into every component that reaches its source, and erasing a node that is a source or
+	// a sink changes nobody else's reach. Any other change marks the index stale, and it is
+	// rebuilt in O(V + E + C^2 / 64) on the next query.
+	//
+	// A query may rebuild the index, so it must not run concurrently with other queries.
+	template<typename N, typename E, typename Storage = tree_storage>
+	class reachability_index : public graph_observer<N, E> {
+	public:
+		explicit reachability_index(graph<N, E, Storage> const& g)
+		: graph_(&g) {
+			rebuild();
+			graph_->subscribe(*this);
+		}
+
+		reachability_index(reachability_index const&) = delete;
+		auto operator=(reachability_index const&) -> reachability_index& = delete;
+
+		~reachability_index() override {
+			if (graph_ != nullptr) {
+				graph_->unsubscribe(*this);
+			}
+		}
+
+		// Whether there is a path from src to dst. Every node reaches itself.
+		template<node_key<N> Src = N, node_key<N> Dst = N>
+		[[nodiscard]] auto reachable(Src const& src, Dst const& dst) const -> bool {
+			if (stale_) {
+				if (graph_ == nullptr) {
+					throw std::runtime_error("Cannot call gdwg::reachability_index::reachable after "
+					                         "its graph was destroyed");
+				}
+				rebuild();
+			}
+			auto const from = rank(src);
+			auto const to = rank(dst);
+			if (from == no_rank || to == no_rank) {
+				throw std::runtime_error("Cannot call gdwg::reachability_index::reachable if src or "
+				                         "dst node don't exist in the graph");
+			}
+			return reaches(component_[from], component_[to]);
+		}
+
+		auto node_inserted(N const& value) -> void override {
+			if (stale_) {
+				return;
+			}
+			if (components_ == words_ * word_bits) {
+				relayout(std::max(words_ * 2, std::size_t{1}));
+			}
+			auto const id = components_++;
+			reach_.resize(components_ * words_);
+			set(id, id);
+
+			auto const position = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			component_.insert(component_.begin() + (position - nodes_.begin()), id);
+			nodes_.insert(position, value);
+		}
+
+		auto edge_inserted(detail::edge_value<N, E> const& edge) -> void override {
+			if (stale_) {
+				return;
+			}
+			auto const from = component_[rank(edge.from)];
+			auto const to = component_[rank(edge.to)];
+			if (reaches(from, to)) {
+				return;
+			}
+			if (reaches(to, from)) {
+				// the edge closes a cycle, merging components
+				stale_ = true;
+				return;
+			}
+			for (auto id = std::size_t{0}; id < components_; ++id) {
+				if (reaches(id, from)) {
+					auto* const row = reach_.data() + id * words_;
+					auto const* const extra = reach_.data() + to * words_;
+					for (auto word = std::size_t{0}; word < words_; ++word) {
+						row[word] |= extra[word];
+					}
+				}
+			}
+		}
+
+		auto node_erased(N const& value) -> void override {
+			if (stale_) {
+				return;
+			}
+			auto const position = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			auto const rank = static_cast<std::size_t>(position - nodes_.begin());
+			auto const id = component_[rank];
+
+			// paths through the node need both an edge in and an edge out, so a source or sink
+			// component of one node leaves everyone else's reach as it was
+			auto alone = std::count(component_.begin(), component_.end(), id) == 1;
+			auto reached_from_others = false;
+			auto reaches_others = false;
+			for (auto other = std::size_t{0}; other < components_ && alone; ++other) {
+				if (other != id) {
+					reached_from_others = reached_from_others || reaches(other, id);
+					reaches_others = reaches_others || reaches(id, other);
+				}
+			}
+			if (!alone || (reached_from_others && reaches_others)) {
+				stale_ = true;
+				return;
+			}
+			nodes_.erase(position);
+			component_.erase(component_.begin() + static_cast<std::ptrdiff_t>(rank));
+		}
+
+		auto edge_erased(detail::edge_value<N, E> const&) -> void override {
+			// reach can only shrink, and finding out where costs as much as a rebuild
+			stale_ = true;
+		}
+
+		auto graph_changed() noexcept -> void override {
+			stale_ = true;
+		}
+
+		auto graph_destroyed() noexcept -> void override {
+			graph_ = nullptr;
+		}
+
+	private:
+		using word_type = std::uint64_t;
+		static constexpr auto word_bits = std::size_t{64};
+
+		graph<N, E, Storage> const* graph_;
+		// sorted nodes and the component of each, by rank
+		mutable std::vector<N> nodes_;
+		mutable std::vector<std::size_t> component_;
+		// row c, words_ words long, holds the components that component c reaches
+		mutable std::vector<word_type> reach_;
+		mutable std::size_t components_ = 0;
+		mutable std::size_t words_ = 0;
+		mutable bool stale_ = false;
+
+		template<typename K>
+		[[nodiscard]] auto rank(K const& key) const -> std::size_t {
+			return detail::find_rank<N>(nodes_, key);
+		}
+
+		[[nodiscard]] auto reaches(std::size_t from, std::size_t to) const -> bool {
+			return ((reach_[from * words_ + to / word_bits] >> (to % word_bits)) & 1U) != 0;
+		}
+
+		auto set(std::size_t from, std::size_t to) const -> void {
+			reach_[from * words_ + to / word_bits] |= word_type{1} << (to % word_bits);
+		}
+
+		auto relayout(std::size_t words) const -> void {
+			auto reach = std::vector<word_type>(components_ * words);
+			for (auto id = std::size_t{0}; id < components_; ++id) {
+				std::copy_n(reach_.begin() + static_cast<std::ptrdiff_t>(id * words_),
+				            words_,
+				            reach.begin() + static_cast<std::ptrdiff_t>(id * words));
+			}
+			reach_.swap(reach);
+			words_ = words;
+		}
+
+		auto rebuild() const -> void {
+			auto const frozen = frozen_graph<N, E>(*graph_);
+			component_ = strongly_connected_components(frozen);
+			components_ = component_.empty()
+			                 ? 0
+			                 : *std::max_element(component_.begin(), component_.end()) + 1;
+			words_ = (components_ + word_bits - 1) / word_bits;
+			reach_.assign(components_ * words_, 0);
+
+			// component ids are topological, so filling rows from the last id down finds every
+			// row an edge leads to already complete
+			auto by_component = std::vector<std::size_t>(frozen.size());
+			auto first = std::vector<std::size_t>(components_ + 1);
+			for (auto const id : component_) {
+				++first[id + 1];
+			}
+			for (auto id = std::size_t{0}; id < components_; ++id) {
+				first[id + 1] += first[id];
+			}
+			auto next = std::vector<std::size_t>(first.cbegin(), first.cend() - 1);
+			for (auto rank = std::size_t{0}; rank < frozen.size(); ++rank) {
+				by_component[next[component_[rank]]++] = rank;
+			}
+
+			for (auto id = components_; id-- > 0;) {
+				set(id, id);
+				auto* const row = reach_.data() + id * words_;
+				for (auto member = first[id]; member < first[id + 1]; ++member) {
+					for (auto const to : frozen.out_neighbours(by_component[member])) {
+						auto const target = component_[to];
+						if (target == id || reaches(id, target)) {
+							continue;
+						}
+						auto const* const extra = reach_.data() + target * words_;
+						for (auto word = std::size_t{0}; word < words_; ++word) {
+							row[word] |= extra[word];
+						}
+					}
+				}
+			}
+			nodes_ = frozen.nodes();
+			stale_ = false;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_REACHABILITY_HPP
@@ -0,0 +1,417 @@
+#ifndef GDWG_SHORTEST_PATHS_HPP
+#define GDWG_SHORTEST_PATHS_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/heap.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Shortest paths over graphs with arithmetic edge weights. Every search runs on a
+// gdwg::frozen_graph; the overloads taking a gdwg::graph build one first, so callers answering
+// many queries on an unchanging graph should freeze it once themselves.
+namespace gdwg {
+	// The result of a single-source search. Both vectors are indexed by node rank, i.e. aligned
+	// with graph::nodes().
+	template<typename W>
+	struct shortest_paths {
+		// unreachable<W> for nodes that were not reached.
+		std::vector<W> distance;
+		// The previous node on a shortest path, or no_rank for the source and unreached nodes.
+		std::vector<std::size_t> predecessor;
+
+		[[nodiscard]] auto reached(std::size_t rank) const -> bool {
+			return distance[rank] != unreachable<W>;
+		}
+
+		// The ranks along a shortest path ending at rank, source first. Empty if rank was not
+		// reached.
+		[[nodiscard]] auto path_to(std::size_t rank) const -> std::vector<std::size_t> {
+			auto path = std::vector<std::size_t>{};
+			if (!reached(rank)) {
+				return path;
+			}
+			for (; rank != no_rank; rank = predecessor[rank]) {
+				path.push_back(rank);
+			}
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+	};
+
+	// All-pairs distances in a dense row-major matrix indexed by node rank, so distance(from, to)
+	// is the distance from the node of rank from to the node of rank to.
+	template<typename W>
+	struct distance_matrix {
+		std::size_t size;
+		// size * size entries, unreachable<W> where there is no path.
+		std::vector<W> distance;
+
+		[[nodiscard]] auto operator()(std::size_t from, std::size_t to) const -> W const& {
+			return distance[from * size + to];
+		}
+
+		[[nodiscard]] auto reached(std::size_t from, std::size_t to) const -> bool {
+			return (*this)(from, to) != unreachable<W>;
+		}
+	};
+
+	namespace detail {
+		// Dijkstra's algorithm from source, stopping once target (if any) is settled.
+		template<typename Heap, typename N, typename E>
+		auto dijkstra(frozen_graph<N, E> const& g,
+		              std::size_t source,
+		              std::size_t target,
+		              char const* negative_weight_error) -> shortest_paths<E> {
+			auto result = shortest_paths<E>{std::vector<E>(g.size(), unreachable<E>),
+			                                std::vector<std::size_t>(g.size(), no_rank)};
+			auto queue = typename Heap::template heap<E>(g.size());
+			result.distance[source] = E{};
+			queue.push(source, E{});
+
+			while (!queue.empty()) {
+				auto const [from, distance] = queue.pop();
+				if (from == target) {
+					break;
+				}
+
+				auto const neighbours = g.out_neighbours(from);
+				auto const weights = g.out_weights(from);
+				for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+					if (weights[i] < E{}) {
+						throw std::runtime_error(negative_weight_error);
+					}
+					auto const to = neighbours[i];
+					auto const candidate = saturating_add(distance, weights[i]);
+					if (candidate < result.distance[to]) {
+						result.distance[to] = candidate;
+						result.predecessor[to] = from;
+						queue.push(to, candidate);
+					}
+				}
+			}
+			return result;
+		}
+
+		// Lowers target to candidate if that is smaller, returning whether it did.
+		template<typename W>
+		auto atomic_min(std::atomic<W>& target, W candidate) -> bool {
+			auto current = target.load(std::memory_order_relaxed);
+			while (candidate < current) {
+				if (target.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		template<typename N, typename E>
+		auto delta_stepping(frozen_graph<N, E> const& g,
+		                    std::size_t source,
+		                    E delta,
+		                    thread_pool& pool) -> std::vector<E> {
+			if (g.min_weight() < E{}) {
+				throw std::runtime_error("Cannot call gdwg::delta_stepping on a graph with negative "
+				                         "edge weights");
+			}
+			if (delta <= E{}) {
+				// the usual choice: about one heavy edge per node per bucket
+				auto const degree = std::max(g.edge_count() / std::max(g.size(), std::size_t{1}),
+				                             std::size_t{1});
+				delta = std::max(static_cast<E>(g.max_weight() / static_cast<E>(degree)), E{1});
+			}
+
+			auto distance = std::vector<std::atomic<E>>(g.size());
+			for (auto& d : distance) {
+				d.store(unreachable<E>, std::memory_order_relaxed);
+			}
+			distance[source].store(E{}, std::memory_order_relaxed);
+
+			// Tentative distances never run further than max_weight past the current bucket, so a
+			// ring of buckets that wide is enough.
+			auto const ring_size = static_cast<std::size_t>(g.max_weight() / delta) + 2;
+			auto ring = std::vector<std::vector<std::size_t>>(ring_size);
+			auto pending = std::size_t{1};
+			ring[0].push_back(source);
+
+			auto const bucket_of = [&](std::size_t rank) {
+				return static_cast<std::size_t>(distance[rank].load(std::memory_order_relaxed) / delta);
+			};
+
+			auto improved = std::vector<std::vector<std::size_t>>(pool.size());
+			auto frontier = std::vector<std::size_t>{};
+			auto settled = std::vector<std::size_t>{};
+			auto in_frontier = std::vector<char>(g.size());
+			auto in_settled = std::vector<char>(g.size());
+
+			// Relaxes the light (weight <= delta) or heavy out-edges of every node in nodes, then
+			// files each node whose distance dropped under its new bucket.
+			auto const relax = [&](std::vector<std::size_t> const& nodes, bool light) {
+				pool.for_each_chunk(
+				   nodes.size(),
+				   pool.default_grain(nodes.size()),
+				   [&](std::size_t first, std::size_t last, std::size_t thread) {
+					   auto& out = improved[thread];
+					   for (; first < last; ++first) {
+						   auto const from = nodes[first];
+						   auto const base = distance[from].load(std::memory_order_relaxed);
+						   auto const neighbours = g.out_neighbours(from);
+						   auto const weights = g.out_weights(from);
+						   for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+							   if ((weights[i] <= delta) != light) {
+								   continue;
+							   }
+							   auto const to = neighbours[i];
+							   if (atomic_min(distance[to], static_cast<E>(base + weights[i]))) {
+								   out.push_back(to);
+							   }
+						   }
+					   }
+				   });
+
+				for (auto& out : improved) {
+					for (auto const to : out) {
+						ring[bucket_of(to) % ring_size].push_back(to);
+					}
+					pending += out.size();
+					out.clear();
+				}
+			};
+
+			for (auto current = std::size_t{0}; pending > 0; ++current) {
+				auto& bucket = ring[current % ring_size];
+				settled.clear();
+				while (!bucket.empty()) {
+					pending -= bucket.size();
+					frontier.clear();
+					for (auto const rank : bucket) {
+						// skip nodes filed twice, or since moved to an earlier bucket
+						if (!in_frontier[rank] && bucket_of(rank) == current) {
+							in_frontier[rank] = 1;
+							frontier.push_back(rank);
+						}
+					}
+					bucket.clear();
+
+					for (auto const rank : frontier) {
+						in_frontier[rank] = 0;
+						if (!in_settled[rank]) {
+							in_settled[rank] = 1;
+							settled.push_back(rank);
+						}
+					}
+					relax(frontier, true);
+				}
+
+				// heavy edges land in later buckets, so each settled node needs relaxing only once
+				for (auto const rank : settled) {
+					in_settled[rank] = 0;
+				}
+				relax(settled, false);
+			}
+
+			auto result = std::vector<E>(g.size());
+			std::transform(distance.cbegin(), distance.cend(), result.begin(), [](auto const& d) {
+				return d.load(std::memory_order_relaxed);
+			});
+			return result;
+		}
+
+		// The nodes of a square tile of a distance matrix, [first, last).
+		struct tile {
+			std::size_t first;
+			std::size_t last;
+		};
+
+		// One Floyd-Warshall step on the to tile of rows: paths from rows to columns through the
+		// via tile, using the (rows, via) and (via, columns) tiles. Any of the three may be the
+		// same tile. The inner loop runs along one contiguous row with no branches, so the
+		// compiler can vectorise it.
+		//
+		// Distances are non-negative, so a sum above none - row[k] would overflow an integral W.
+		// Such paths saturate at none instead, which also covers a via term that is none itself;
+		// for floating W, none is infinity and the test never holds.
+		template<typename W>
+		auto relax_tile(std::vector<W>& distance, std::size_t size, tile rows, tile via, tile columns)
+		   -> void {
+			constexpr auto none = unreachable<W>;
+			for (auto k = via.first; k < via.last; ++k) {
+				auto const* const through = distance.data() + k * size;
+				for (auto i = rows.first; i < rows.last; ++i) {
+					auto* const row = distance.data() + i * size;
+					auto const to_k = row[k];
+					if (to_k == none) {
+						continue;
+					}
+					auto const room = static_cast<W>(none - to_k);
+					for (auto j = columns.first; j < columns.last; ++j) {
+						auto const via_k = through[j] > room ? none : static_cast<W>(to_k + through[j]);
+						row[j] = std::min(row[j], via_k);
+					}
+				}
+			}
+		}
+	} // namespace detail
+
+	// Distances from src to every node. Heap is binary_heap, pairing_heap or radix_heap (see
+	// gdwg/heap.hpp); radix_heap needs integral weights.
+	template<typename Heap = binary_heap, typename N, typename E, node_key<N> K>
+	requires std::is_arithmetic_v<E>
+	auto dijkstra(frozen_graph<N, E> const& g, K const& src) -> shortest_paths<E> {
+		auto const source = g.rank(src);
+		if (source == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::dijkstra if src doesn't exist in the graph");
+		}
+		return detail::dijkstra<Heap>(g,
+		                              source,
+		                              no_rank,
+		                              "Cannot call gdwg::dijkstra on a graph with negative edge "
+		                              "weights");
+	}
+
+	template<typename Heap = binary_heap, typename N, typename E, typename Storage, node_key<N> K>
+	requires std::is_arithmetic_v<E>
+	auto dijkstra(graph<N, E, Storage> const& g, K const& src) -> shortest_paths<E> {
+		return dijkstra<Heap>(frozen_graph<N, E>(g), src);
+	}
+
+	// Like dijkstra, but stops as soon as dst is settled. Only dst and the nodes settled before
+	// it are guaranteed to hold their final distance and predecessor.
+	template<typename Heap = binary_heap,
+	         typename N,
+	         typename E,
+	         node_key<N> Src,
+	         node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto shortest_path(frozen_graph<N, E> const& g, Src const& src, Dst const& dst)
+	   -> shortest_paths<E> {
+		auto const source = g.rank(src);
+		auto const target = g.rank(dst);
+		if (source == no_rank || target == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::shortest_path if src or dst node don't exist "
+			                         "in the graph");
+		}
+		return detail::dijkstra<Heap>(g,
+		                              source,
+		                              target,
+		                              "Cannot call gdwg::shortest_path on a graph with negative edge "
+		                              "weights");
+	}
+
+	template<typename Heap = binary_heap,
+	         typename N,
+	         typename E,
+	         typename Storage,
+	         node_key<N> Src,
+	         node_key<N> Dst>
+	requires std::is_arithmetic_v<E>
+	auto shortest_path(graph<N, E, Storage> const& g, Src const& src, Dst const& dst)
+	   -> shortest_paths<E> {
+		return shortest_path<Heap>(frozen_graph<N, E>(g), src, dst);
+	}
+
+	// Distances from src to every node by delta-stepping (Meyer and Sanders), relaxing each bucket
+	// of nodes in parallel on pool. Weights must be non-negative integers. A delta of zero picks
+	// one from the weights and average degree; a delta far below the largest weight costs one
+	// bucket per delta of that weight. Only distances are computed; use dijkstra when the paths
+	// themselves are needed.
+	template<typename N, typename E, node_key<N> K>
+	requires std::is_integral_v<E>
+	auto delta_stepping(frozen_graph<N, E> const& g,
+	                    K const& src,
+	                    E delta = E{},
+	                    thread_pool& pool = default_thread_pool()) -> std::vector<E> {
+		auto const source = g.rank(src);
+		if (source == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if src doesn't exist in the "
+			                         "graph");
+		}
+		return detail::delta_stepping(g, source, delta, pool);
+	}
+
+	template<typename N, typename E, typename Storage, node_key<N> K>
+	requires std::is_integral_v<E>
+	auto delta_stepping(graph<N, E, Storage> const& g,
+	                    K const& src,
+	                    E delta = E{},
+	                    thread_pool& pool = default_thread_pool()) -> std::vector<E> {
+		return delta_stepping(frozen_graph<N, E>(g), src, delta, pool);
+	}
+
+	// Distances between every pair of nodes by Floyd-Warshall, for small dense graphs: the
+	// matrix takes V^2 space and V^3 time. Weights must be non-negative; parallel edges count by
+	// their lightest. For integral E, a pair whose distance does not fit in E is unreachable<E>.
+	//
+	// The matrix is processed in square tiles small enough that three stay in cache. For each
+	// diagonal tile in turn, that tile is closed first, then the rest of its row and column of
+	// tiles, then every other tile; the tiles of each of the last two phases are independent of
+	// each other and are spread across pool.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto all_pairs_shortest_paths(frozen_graph<N, E> const& g,
+	                              thread_pool& pool = default_thread_pool())
+	   -> distance_matrix<E> {
+		constexpr auto tile_size = std::size_t{64};
+		if (g.edge_count() > 0 && g.min_weight() < E{}) {
+			throw std::runtime_error("Cannot call gdwg::all_pairs_shortest_paths on a graph with "
+			                         "negative edge weights");
+		}
+
+		auto const size = g.size();
+		auto result = distance_matrix<E>{size, std::vector<E>(size * size, unreachable<E>)};
+		auto& distance = result.distance;
+		pool.for_each_index(size, [&](std::size_t from, std::size_t) {
+			auto* const row = distance.data() + from * size;
+			row[from] = E{};
+			auto const neighbours = g.out_neighbours(from);
+			auto const weights = g.out_weights(from);
+			for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+				row[neighbours[i]] = std::min(row[neighbours[i]], weights[i]);
+			}
+		});
+
+		auto const tiles = (size + tile_size - 1) / tile_size;
+		auto const nth = [&](std::size_t index) {
+			return detail::tile{index * tile_size, std::min((index + 1) * tile_size, size)};
+		};
+		for (auto k = std::size_t{0}; k < tiles; ++k) {
+			auto const via = nth(k);
+			// the tiles other than k, numbered from zero
+			auto const other = [&](std::size_t index) { return nth(index < k ? index : index + 1); };
+			detail::relax_tile(distance, size, via, via, via);
+			// the first tiles - 1 indices are the rest of row k, the others the rest of column k
+			pool.for_each_index(2 * (tiles - 1), [&](std::size_t index, std::size_t) {
+				if (index < tiles - 1) {
+					detail::relax_tile(distance, size, via, via, other(index));
+				}
+				else {
+					detail::relax_tile(distance, size, other(index - (tiles - 1)), via, via);
+				}
+			});
+			pool.for_each_index((tiles - 1) * (tiles - 1), [&](std::size_t index, std::size_t) {
+				detail::relax_tile(distance,
+				                   size,
+				                   other(index / (tiles - 1)),
+				                   via,
+				                   other(index % (tiles - 1)));
+			});
+		}
+		return result;
+	}
+
+	template<typename N, typename E, typename Storage>
+	requires std::is_arithmetic_v<E>
+	auto all_pairs_shortest_paths(graph<N, E, Storage> const& g,
+	                              thread_pool& pool = default_thread_pool())
+	   -> distance_matrix<E> {
+		return all_pairs_shortest_paths(frozen_graph<N, E>(g), pool);
+	}
+} // namespace gdwg
+
+#endif // GDWG_SHORTEST_PATHS_HPP
@@ -0,0 +1,130 @@
+#ifndef GDWG_SPANNING_HPP
+#define GDWG_SPANNING_HPP
+
+#include <gdwg/components.hpp>
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	// A minimum spanning forest of the graph with edge directions ignored: one spanning tree per
+	// weakly connected component, of the least total weight. Of parallel edges (either way round)
+	// only the lightest can be chosen, and self-loops never are. Edges of a graph<N, void> all
+	// weigh the same. The chosen edges are returned as they appear in the graph, in its iteration
+	// order.
+	//
+	// Runs Borůvka's algorithm: each round every component picks its lightest edge to another
+	// component, found by scanning the edges in parallel across pool with an atomic minimum per
+	// component, and then all the picks are merged at once in a lock-free union-find. Ties are
+	// broken by edge order, so the picks never form a cycle, and each round at least halves the
+	// number of components.
+	template<typename N, typename E>
+	auto minimum_spanning_forest(frozen_graph<N, E> const& g,
+	                             thread_pool& pool = default_thread_pool())
+	   -> std::vector<detail::edge_value<N, E>> {
+		constexpr auto no_edge = no_rank;
+		auto const size = g.size();
+
+		auto source = std::vector<std::size_t>(g.edge_count());
+		pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+			auto const first = g.first_out_edge(rank);
+			std::fill_n(source.begin() + static_cast<std::ptrdiff_t>(first), g.out_degree(rank), rank);
+		});
+		// whether edge lhs is lighter than edge rhs, in a strict total order
+		auto const lighter = [&g](std::size_t lhs, std::size_t rhs) {
+			if (rhs == no_edge) {
+				return true;
+			}
+			if constexpr (!std::is_void_v<E>) {
+				if (g.weight(lhs) < g.weight(rhs)) {
+					return true;
+				}
+				if (g.weight(rhs) < g.weight(lhs)) {
+					return false;
+				}
+			}
+			return lhs < rhs;
+		};
+
+		auto sets = detail::concurrent_disjoint_sets(size);
+		auto lightest = std::vector<std::atomic<std::size_t>>(size);
+		auto chosen = std::vector<std::vector<std::size_t>>(pool.size());
+		auto const chosen_count = [&chosen] {
+			auto count = std::size_t{0};
+			for (auto const& edges : chosen) {
+				count += edges.size();
+			}
+			return count;
+		};
+		for (auto previous = no_edge; previous != chosen_count();) {
+			previous = chosen_count();
+			pool.for_each_index(size, [&](std::size_t rank, std::size_t) {
+				lightest[rank].store(no_edge, std::memory_order_relaxed);
+			});
+
+			pool.for_each_chunk(
+			   g.edge_count(),
+			   pool.default_grain(g.edge_count()),
+			   [&](std::size_t first, std::size_t last, std::size_t) {
+				   for (auto edge = first; edge < last; ++edge) {
+					   auto const from = sets.find(source[edge]);
+					   auto const to = sets.find(g.target(edge));
+					   if (from == to) {
+						   continue;
+					   }
+					   for (auto const component : {from, to}) {
+						   auto current = lightest[component].load(std::memory_order_relaxed);
+						   while (lighter(edge, current)
+						          && !lightest[component].compare_exchange_weak(
+						             current,
+						             edge,
+						             std::memory_order_relaxed))
+						   {
+						   }
+					   }
+				   }
+			   });
+
+			// two components may pick the same edge, but it only joins them once
+			pool.for_each_index(size, [&](std::size_t rank, std::size_t thread) {
+				auto const edge = lightest[rank].load(std::memory_order_relaxed);
+				if (edge != no_edge && sets.unite(source[edge], g.target(edge))) {
+					chosen[thread].push_back(edge);
+				}
+			});
+		}
+
+		auto edges = std::vector<std::size_t>{};
+		edges.reserve(chosen_count());
+		for (auto const& mine : chosen) {
+			edges.insert(edges.end(), mine.begin(), mine.end());
+		}
+		std::sort(edges.begin(), edges.end());
+		auto result = std::vector<detail::edge_value<N, E>>{};
+		result.reserve(edges.size());
+		for (auto const edge : edges) {
+			if constexpr (std::is_void_v<E>) {
+				result.push_back({g.node(source[edge]), g.node(g.target(edge))});
+			}
+			else {
+				result.push_back({g.node(source[edge]), g.node(g.target(edge)), g.weight(edge)});
+			}
+		}
+		return result;
+	}
+
+	template<typename N, typename E, typename Storage>
+	auto minimum_spanning_forest(graph<N, E, Storage> const& g,
+	                             thread_pool& pool = default_thread_pool())
+	   -> std::vector<typename graph<N, E, Storage>::value_type> {
+		return minimum_spanning_forest(frozen_graph<N, E>(g), pool);
+	}
+} // namespace gdwg
+
+#endif // GDWG_SPANNING_HPP
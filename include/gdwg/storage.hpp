@@ -0,0 +1,1033 @@
+#ifndef GDWG_STORAGE_HPP
+#define GDWG_STORAGE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Storage policies decide how a gdwg::graph indexes its nodes and lays out each node's outgoing
+// edges. A policy is a type with a nested `storage<N, E>` class template, and the graph only ever
+// talks to that class. Every storage keeps nodes in ascending order and each node's edges ordered
+// by destination, then weight, so the graph's observable ordering does not depend on the policy.
+//
+// A user-provided policy works the same way: its storage<N, E> must model gdwg::graph_storage.
+namespace gdwg {
+	// The interface gdwg::graph is written against. node_iterator walks nodes in ascending order and
+	// edge_iterator walks one node's edges in (destination, weight) order; neither needs to be
+	// dereferenceable, as values are read back through the storage. Mutating members may invalidate
+	// every node_iterator and edge_iterator, except that erase_edge returns the edge after the one
+	// erased.
+	//
+	// find_node may also accept other key types (see gdwg::node_key). gdwg::graph uses such an
+	// overload when the storage has one, and otherwise converts the key to N before looking it up.
+	//
+	// A storage may also provide append_node(value), for a node greater than every node it has,
+	// and append_edge(src, dst, weight), for an edge ordered after every edge of src. They skip
+	// searching for where the node or edge goes, and must not invalidate any node_iterator.
+	// gdwg::graph uses them when it builds a graph in order, and otherwise falls back to
+	// insert_node and insert_edge.
+	template<typename S, typename N, typename E>
+	concept graph_storage =
+	   std::semiregular<S> && std::semiregular<typename S::node_iterator>
+	   && std::semiregular<typename S::edge_iterator>
+	   && requires(S& s,
+	               S const& cs,
+	               N const& value,
+	               E const& weight,
+	               typename S::node_iterator node,
+	               typename S::edge_iterator e) {
+		   { cs.empty() } -> std::convertible_to<bool>;
+		   { cs.node_begin() } -> std::same_as<typename S::node_iterator>;
+		   { cs.node_end() } -> std::same_as<typename S::node_iterator>;
+		   { cs.find_node(value) } -> std::same_as<typename S::node_iterator>;
+		   { cs.value(node) } -> std::convertible_to<N const&>;
+		   { cs.edge_begin(node) } -> std::same_as<typename S::edge_iterator>;
+		   { cs.edge_end(node) } -> std::same_as<typename S::edge_iterator>;
+		   { cs.destination(e) } -> std::convertible_to<N const&>;
+		   { cs.weight(e) } -> std::convertible_to<E const&>;
+		   {
+			   cs.edges_to(node, node)
+			   } -> std::same_as<std::pair<typename S::edge_iterator, typename S::edge_iterator>>;
+		   { cs.find_edge(node, node, weight) } -> std::same_as<typename S::edge_iterator>;
+		   { s.insert_node(value) } -> std::same_as<bool>;
+		   { s.insert_edge(node, node, weight) } -> std::same_as<bool>;
+		   { s.erase_edge(node, e) } -> std::same_as<typename S::edge_iterator>;
+		   s.erase_node(node);
+		   s.clear();
+		   { ++node } -> std::same_as<typename S::node_iterator&>;
+		   { --node } -> std::same_as<typename S::node_iterator&>;
+		   { node == node } -> std::convertible_to<bool>;
+		   { ++e } -> std::same_as<typename S::edge_iterator&>;
+		   { --e } -> std::same_as<typename S::edge_iterator&>;
+		   { e == e } -> std::convertible_to<bool>;
+	   };
+
+	// A type that nodes of type N can be looked up by, such as std::string_view or char const* for
+	// std::string. It must order and compare equal consistently with N itself.
+	template<typename K, typename N>
+	concept node_key = requires(K const& key, N const& value) {
+		{ key < value } -> std::convertible_to<bool>;
+		{ value < key } -> std::convertible_to<bool>;
+		{ key == value } -> std::convertible_to<bool>;
+	};
+
+	namespace detail {
+		// Whether key still holds the same number once converted to the integral type N, so that a
+		// key outside N's range cannot wrap around onto a node and a fractional one cannot be
+		// truncated onto one.
+		template<typename N, typename K>
+		constexpr auto representable(K key) noexcept -> bool {
+			if constexpr (std::is_floating_point_v<K>) {
+				// N holds [-2^digits, 2^digits) or [0, 2^digits), and converting anything outside
+				// that, NaN included, is undefined
+				auto const bound = static_cast<K>(std::numeric_limits<N>::max() / 2 + 1) * 2;
+				auto const lowest = std::is_signed_v<N> ? -bound : K{0};
+				if (!(key >= lowest && key < bound)) {
+					return false;
+				}
+			}
+			auto const value = static_cast<N>(key);
+			if (static_cast<K>(value) != key) {
+				return false;
+			}
+			if constexpr (std::is_signed_v<K> && !std::is_signed_v<N>) {
+				return key >= 0;
+			}
+			else if constexpr (!std::is_signed_v<K> && std::is_signed_v<N>) {
+				return value >= 0;
+			}
+			else {
+				return true;
+			}
+		}
+
+		template<typename T>
+		concept string_like = std::convertible_to<T const&, std::string_view>;
+
+		// The weight stored for gdwg::graph<N, void>. All values are equivalent, so it takes no space
+		// in an edge and storages skip comparing it.
+		struct no_weight {
+			friend constexpr auto operator==(no_weight, no_weight) noexcept -> bool {
+				return true;
+			}
+
+			friend constexpr auto operator<(no_weight, no_weight) noexcept -> bool {
+				return false;
+			}
+		};
+	} // namespace detail
+
+	// Nodes are owned through std::shared_ptr and indexed by a std::set / std::map, with each
+	// node's edges in a std::set. This is the general-purpose default.
+	struct tree_storage {
+		template<typename N, typename E>
+		class storage;
+	};
+
+	// Integral nodes are indexed directly by value in a vector, with an occupancy bitmap recording
+	// which values are nodes. Edges store their destination inline in a sorted vector. Memory grows
+	// with the spread of node values (max - min), not the number of nodes, so this only pays off
+	// when node values are reasonably dense.
+	struct dense_storage {
+		template<typename N, typename E>
+		class storage;
+	};
+
+	// Nodes and each node's edges are kept in sorted vectors. Lookups are binary searches over
+	// contiguous memory and iteration is a linear scan, but inserting or erasing a node shifts every
+	// node after it. Suited to graphs that are built once, ideally in ascending node order, and then
+	// mostly read.
+	struct flat_storage {
+		template<typename N, typename E>
+		class storage;
+	};
+
+	// Nodes are indexed by a std::unordered_map, so finding a node is O(1) on average, and a sorted
+	// vector of the map's entries provides ordered iteration. Each node's edges are a sorted vector.
+	// Inserting or erasing a node is O(n) to keep the order current, so this suits read-heavy
+	// graphs with a stable node set.
+	struct hash_storage {
+		template<typename N, typename E>
+		class storage;
+	};
+
+	template<typename N, typename E>
+	class tree_storage::storage {
+		struct edge {
+			std::shared_ptr<N> to;
+			[[no_unique_address]] E weight;
+		};
+
+		struct node_comparator {
+			using is_transparent = void;
+
+			auto operator()(std::shared_ptr<N> const& lhs, std::shared_ptr<N> const& rhs) const -> bool {
+				return *lhs < *rhs;
+			}
+
+			template<node_key<N> K>
+			auto operator()(std::shared_ptr<N> const& lhs, K const& rhs) const -> bool {
+				return *lhs < rhs;
+			}
+
+			template<node_key<N> K>
+			auto operator()(K const& lhs, std::shared_ptr<N> const& rhs) const -> bool {
+				return lhs < *rhs;
+			}
+		};
+
+		// Edges can also be looked up by destination alone, which finds every parallel edge.
+		struct edge_comparator {
+			using is_transparent = void;
+
+			auto operator()(edge const& lhs, edge const& rhs) const -> bool {
+				if constexpr (std::is_same_v<E, detail::no_weight>) {
+					return *lhs.to < *rhs.to;
+				}
+				else {
+					if (*lhs.to == *rhs.to) {
+						return lhs.weight < rhs.weight;
+					}
+					return *lhs.to < *rhs.to;
+				}
+			}
+
+			auto operator()(edge const& lhs, N const& rhs) const -> bool {
+				return *lhs.to < rhs;
+			}
+
+			auto operator()(N const& lhs, edge const& rhs) const -> bool {
+				return lhs < *rhs.to;
+			}
+		};
+
+		using edge_list = std::set<edge, edge_comparator>;
+		using edge_map = std::map<std::shared_ptr<N>, edge_list, node_comparator>;
+
+	public:
+		using node_iterator = typename edge_map::const_iterator;
+		using edge_iterator = typename edge_list::const_iterator;
+
+		storage() = default;
+
+		storage(storage const& other) {
+			std::for_each(other.nodes_.cbegin(), other.nodes_.cend(), [this](auto const& n) {
+				insert_node(*n);
+			});
+
+			// edges must point at this storage's copies of the nodes
+			for (auto const& [src, other_edges] : other.edges_) {
+				auto& edges = edges_.find(*src)->second;
+				for (auto const& other_edge : other_edges) {
+					edges.emplace_hint(edges.end(), edge{*nodes_.find(*other_edge.to), other_edge.weight});
+				}
+			}
+		}
+
+		storage(storage&&) noexcept = default;
+
+		auto operator=(storage const& other) -> storage& {
+			auto copy = other;
+			std::swap(*this, copy);
+			return *this;
+		}
+
+		auto operator=(storage&&) noexcept -> storage& = default;
+
+		~storage() = default;
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+
+		[[nodiscard]] auto node_begin() const noexcept -> node_iterator {
+			return edges_.begin();
+		}
+
+		[[nodiscard]] auto node_end() const noexcept -> node_iterator {
+			return edges_.end();
+		}
+
+		template<node_key<N> K>
+		[[nodiscard]] auto find_node(K const& key) const -> node_iterator {
+			return edges_.find(key);
+		}
+
+		[[nodiscard]] auto value(node_iterator node) const -> N const& {
+			return *node->first;
+		}
+
+		[[nodiscard]] auto edge_begin(node_iterator node) const -> edge_iterator {
+			return node->second.begin();
+		}
+
+		[[nodiscard]] auto edge_end(node_iterator node) const -> edge_iterator {
+			return node->second.end();
+		}
+
+		[[nodiscard]] auto destination(edge_iterator e) const -> N const& {
+			return *e->to;
+		}
+
+		[[nodiscard]] auto weight(edge_iterator e) const -> E const& {
+			return e->weight;
+		}
+
+		// All edges src -> dst, ordered by weight.
+		[[nodiscard]] auto edges_to(node_iterator src, node_iterator dst) const
+		   -> std::pair<edge_iterator, edge_iterator> {
+			return src->second.equal_range(*dst->first);
+		}
+
+		[[nodiscard]] auto find_edge(node_iterator src, node_iterator dst, E const& weight) const
+		   -> edge_iterator {
+			return src->second.find(edge{dst->first, weight});
+		}
+
+		auto insert_node(N const& value) -> bool {
+			if (find_node(value) != node_end()) {
+				return false;
+			}
+			auto node = std::make_shared<N>(value);
+			nodes_.emplace(node);
+			edges_.emplace(node, edge_list());
+			return true;
+		}
+
+		auto insert_edge(node_iterator src, node_iterator dst, E const& weight) -> bool {
+			return mutable_edges(src).emplace(edge{dst->first, weight}).second;
+		}
+
+		auto append_node(N const& value) -> void {
+			auto node = std::make_shared<N>(value);
+			nodes_.emplace_hint(nodes_.end(), node);
+			edges_.emplace_hint(edges_.end(), node, edge_list());
+		}
+
+		auto append_edge(node_iterator src, node_iterator dst, E const& weight) -> void {
+			auto& edges = mutable_edges(src);
+			edges.emplace_hint(edges.end(), edge{dst->first, weight});
+		}
+
+		auto erase_edge(node_iterator src, edge_iterator e) -> edge_iterator {
+			return mutable_edges(src).erase(e);
+		}
+
+		// Removes the node together with all of its incoming and outgoing edges.
+		auto erase_node(node_iterator node) -> void {
+			auto const erased = node->first;
+			for (auto& [src, edges] : edges_) {
+				auto const [first, last] = edges.equal_range(*erased);
+				edges.erase(first, last);
+			}
+			edges_.erase(node);
+			nodes_.erase(nodes_.find(*erased));
+		}
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+			edges_.clear();
+		}
+
+	private:
+		std::set<std::shared_ptr<N>, node_comparator> nodes_;
+		edge_map edges_;
+
+		auto mutable_edges(node_iterator node) -> edge_list& {
+			// erasing an empty range is the usual O(1) way to turn a const_iterator into an iterator
+			return edges_.erase(node, node)->second;
+		}
+	};
+
+	template<typename N, typename E>
+	class dense_storage::storage {
+		static_assert(std::is_integral_v<N> && !std::is_same_v<N, bool>,
+		              "gdwg::dense_storage requires an integral node type");
+
+		using offset_type = std::make_unsigned_t<N>;
+		using word_type = std::uint64_t;
+		static constexpr auto word_bits =
+		   static_cast<std::size_t>(std::numeric_limits<word_type>::digits);
+
+		struct edge {
+			N to;
+			[[no_unique_address]] E weight;
+		};
+
+		struct edge_comparator {
+			auto operator()(edge const& lhs, edge const& rhs) const -> bool {
+				if constexpr (std::is_same_v<E, detail::no_weight>) {
+					return lhs.to < rhs.to;
+				}
+				else {
+					if (lhs.to == rhs.to) {
+						return lhs.weight < rhs.weight;
+					}
+					return lhs.to < rhs.to;
+				}
+			}
+
+			auto operator()(edge const& lhs, N rhs) const -> bool {
+				return lhs.to < rhs;
+			}
+
+			auto operator()(N lhs, edge const& rhs) const -> bool {
+				return lhs < rhs.to;
+			}
+		};
+
+		using edge_list = std::vector<edge>;
+
+	public:
+		class node_iterator {
+		public:
+			node_iterator() = default;
+
+			auto operator++() -> node_iterator& {
+				index_ = storage_->next_node(index_ + 1);
+				return *this;
+			}
+
+			auto operator--() -> node_iterator& {
+				index_ = storage_->prev_node(index_);
+				return *this;
+			}
+
+			auto operator==(node_iterator const& other) const -> bool = default;
+
+		private:
+			node_iterator(storage const* owner, std::size_t index)
+			: storage_(owner)
+			, index_(index) {}
+
+			storage const* storage_ = nullptr;
+			std::size_t index_ = 0;
+			friend class storage;
+		};
+
+		using edge_iterator = typename edge_list::const_iterator;
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size_ == 0;
+		}
+
+		[[nodiscard]] auto node_begin() const noexcept -> node_iterator {
+			return node_iterator(this, next_node(0));
+		}
+
+		[[nodiscard]] auto node_end() const noexcept -> node_iterator {
+			return node_iterator(this, adjacency_.size());
+		}
+
+		[[nodiscard]] auto find_node(N const& value) const -> node_iterator {
+			if (adjacency_.empty() || value < base_) {
+				return node_end();
+			}
+			auto const index = distance(base_, value);
+			if (index >= adjacency_.size() || !occupied(index)) {
+				return node_end();
+			}
+			return node_iterator(this, index);
+		}
+
+		[[nodiscard]] auto value(node_iterator node) const -> N {
+			return static_cast<N>(static_cast<offset_type>(base_) + static_cast<offset_type>(node.index_));
+		}
+
+		[[nodiscard]] auto edge_begin(node_iterator node) const -> edge_iterator {
+			return adjacency_[node.index_].cbegin();
+		}
+
+		[[nodiscard]] auto edge_end(node_iterator node) const -> edge_iterator {
+			return adjacency_[node.index_].cend();
+		}
+
+		[[nodiscard]] auto destination(edge_iterator e) const -> N const& {
+			return e->to;
+		}
+
+		[[nodiscard]] auto weight(edge_iterator e) const -> E const& {
+			return e->weight;
+		}
+
+		[[nodiscard]] auto edges_to(node_iterator src, node_iterator dst) const
+		   -> std::pair<edge_iterator, edge_iterator> {
+			auto const& edges = adjacency_[src.index_];
+			return std::equal_range(edges.cbegin(), edges.cend(), value(dst), edge_comparator{});
+		}
+
+		[[nodiscard]] auto find_edge(node_iterator src, node_iterator dst, E const& weight) const
+		   -> edge_iterator {
+			auto const& edges = adjacency_[src.index_];
+			auto const key = edge{value(dst), weight};
+			auto const e = std::lower_bound(edges.cbegin(), edges.cend(), key, edge_comparator{});
+			if (e == edges.cend() || edge_comparator{}(key, *e)) {
+				return edges.cend();
+			}
+			return e;
+		}
+
+		auto insert_node(N const& value) -> bool {
+			if (find_node(value) != node_end()) {
+				return false;
+			}
+
+			if (adjacency_.empty()) {
+				base_ = value;
+			}
+			else if (value < base_) {
+				grow_front(value);
+			}
+
+			auto const index = distance(base_, value);
+			if (index >= adjacency_.size()) {
+				check_span(index, 1);
+				adjacency_.resize(index + 1);
+				occupied_.resize((adjacency_.size() + word_bits - 1) / word_bits);
+			}
+			occupied_[index / word_bits] |= word_type{1} << (index % word_bits);
+			++size_;
+			return true;
+		}
+
+		auto insert_edge(node_iterator src, node_iterator dst, E const& weight) -> bool {
+			auto& edges = adjacency_[src.index_];
+			auto const key = edge{value(dst), weight};
+			auto const e = std::lower_bound(edges.begin(), edges.end(), key, edge_comparator{});
+			if (e != edges.end() && !edge_comparator{}(key, *e)) {
+				return false;
+			}
+			edges.insert(e, key);
+			return true;
+		}
+
+		// Values are indexed directly, so only edges gain anything from being appended.
+		auto append_edge(node_iterator src, node_iterator dst, E const& weight) -> void {
+			adjacency_[src.index_].push_back(edge{value(dst), weight});
+		}
+
+		auto erase_edge(node_iterator src, edge_iterator e) -> edge_iterator {
+			return adjacency_[src.index_].erase(e);
+		}
+
+		// Removes the node together with all of its incoming and outgoing edges.
+		auto erase_node(node_iterator node) -> void {
+			auto const erased = value(node);
+			adjacency_[node.index_] = edge_list();
+			occupied_[node.index_ / word_bits] &= ~(word_type{1} << (node.index_ % word_bits));
+			if (--size_ == 0) {
+				clear();
+				return;
+			}
+
+			for (auto src = node_begin(); src != node_end(); ++src) {
+				auto& edges = adjacency_[src.index_];
+				auto const [first, last] =
+				   std::equal_range(edges.begin(), edges.end(), erased, edge_comparator{});
+				edges.erase(first, last);
+			}
+		}
+
+		auto clear() noexcept -> void {
+			adjacency_.clear();
+			occupied_.clear();
+			size_ = 0;
+		}
+
+	private:
+		N base_ = N();
+		std::size_t size_ = 0;
+		std::vector<edge_list> adjacency_;
+		std::vector<word_type> occupied_;
+
+		// Number of values in [from, to); computed unsigned so that it cannot overflow.
+		static auto distance(N from, N to) -> std::size_t {
+			return static_cast<std::size_t>(
+			   static_cast<offset_type>(static_cast<offset_type>(to) - static_cast<offset_type>(from)));
+		}
+
+		[[nodiscard]] auto occupied(std::size_t index) const noexcept -> bool {
+			return ((occupied_[index / word_bits] >> (index % word_bits)) & 1U) != 0;
+		}
+
+		// Index of the first node at or after index, or adjacency_.size() if there is none.
+		[[nodiscard]] auto next_node(std::size_t index) const noexcept -> std::size_t {
+			auto word = index / word_bits;
+			if (word >= occupied_.size()) {
+				return adjacency_.size();
+			}
+			auto bits = occupied_[word] & (~word_type{0} << (index % word_bits));
+			while (bits == 0) {
+				if (++word == occupied_.size()) {
+					return adjacency_.size();
+				}
+				bits = occupied_[word];
+			}
+			return word * word_bits + static_cast<std::size_t>(std::countr_zero(bits));
+		}
+
+		// Index of the last node before index. There must be one.
+		[[nodiscard]] auto prev_node(std::size_t index) const noexcept -> std::size_t {
+			--index;
+			auto word = index / word_bits;
+			auto bits = occupied_[word] & (~word_type{0} >> (word_bits - 1 - index % word_bits));
+			while (bits == 0) {
+				bits = occupied_[--word];
+			}
+			return word * word_bits + word_bits - 1 - static_cast<std::size_t>(std::countl_zero(bits));
+		}
+
+		// Throws unless size + extra slots fit in a vector, before anything has changed. Node values
+		// spread across most of a 64-bit range would otherwise overflow the slot count or ask for
+		// far more memory than exists.
+		auto check_span(std::size_t size, std::size_t extra) const -> void {
+			auto const limit = adjacency_.max_size();
+			if (size > limit || extra > limit - size) {
+				throw std::length_error("Cannot call gdwg::graph<N, E>::insert_node with "
+				                        "gdwg::dense_storage on node values spread too far apart");
+			}
+		}
+
+		// Moves base_ down to make room for value. Extra slack proportional to the current span
+		// keeps repeated insertions below the minimum amortised O(1) per slot.
+		auto grow_front(N value) -> void {
+			auto const slack = std::min(adjacency_.size(), distance(std::numeric_limits<N>::min(), value));
+			auto const shift = distance(value, base_) + slack;
+			check_span(adjacency_.size(), shift);
+			base_ = static_cast<N>(static_cast<offset_type>(value) - static_cast<offset_type>(slack));
+
+			auto shifted = std::vector<word_type>((adjacency_.size() + shift + word_bits - 1) / word_bits);
+			for (auto index = next_node(0); index != adjacency_.size(); index = next_node(index + 1)) {
+				auto const moved = index + shift;
+				shifted[moved / word_bits] |= word_type{1} << (moved % word_bits);
+			}
+			adjacency_.insert(adjacency_.begin(), shift, edge_list());
+			occupied_ = std::move(shifted);
+		}
+	};
+
+	template<typename N, typename E>
+	class flat_storage::storage {
+		struct edge {
+			N const* to;
+			[[no_unique_address]] E weight;
+		};
+
+		struct node {
+			std::unique_ptr<N> value;
+			std::vector<edge> edges;
+		};
+
+		struct node_comparator {
+			template<node_key<N> K>
+			auto operator()(node const& lhs, K const& rhs) const -> bool {
+				return *lhs.value < rhs;
+			}
+
+			template<node_key<N> K>
+			auto operator()(K const& lhs, node const& rhs) const -> bool {
+				return lhs < *rhs.value;
+			}
+		};
+
+		struct edge_comparator {
+			auto operator()(edge const& lhs, edge const& rhs) const -> bool {
+				if constexpr (std::is_same_v<E, detail::no_weight>) {
+					return *lhs.to < *rhs.to;
+				}
+				else {
+					if (*lhs.to == *rhs.to) {
+						return lhs.weight < rhs.weight;
+					}
+					return *lhs.to < *rhs.to;
+				}
+			}
+
+			auto operator()(edge const& lhs, N const& rhs) const -> bool {
+				return *lhs.to < rhs;
+			}
+
+			auto operator()(N const& lhs, edge const& rhs) const -> bool {
+				return lhs < *rhs.to;
+			}
+		};
+
+	public:
+		using node_iterator = typename std::vector<node>::const_iterator;
+		using edge_iterator = typename std::vector<edge>::const_iterator;
+
+		storage() = default;
+
+		storage(storage const& other) {
+			nodes_.reserve(other.nodes_.size());
+			for (auto const& n : other.nodes_) {
+				nodes_.push_back(node{std::make_unique<N>(*n.value), {}});
+			}
+
+			// edges must point at this storage's copies of the nodes
+			for (auto i = std::size_t{0}; i < nodes_.size(); ++i) {
+				auto& edges = nodes_[i].edges;
+				edges.reserve(other.nodes_[i].edges.size());
+				for (auto const& other_edge : other.nodes_[i].edges) {
+					edges.push_back(edge{find_node(*other_edge.to)->value.get(), other_edge.weight});
+				}
+			}
+		}
+
+		storage(storage&&) noexcept = default;
+
+		auto operator=(storage const& other) -> storage& {
+			auto copy = other;
+			std::swap(*this, copy);
+			return *this;
+		}
+
+		auto operator=(storage&&) noexcept -> storage& = default;
+
+		~storage() = default;
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+
+		[[nodiscard]] auto node_begin() const noexcept -> node_iterator {
+			return nodes_.cbegin();
+		}
+
+		[[nodiscard]] auto node_end() const noexcept -> node_iterator {
+			return nodes_.cend();
+		}
+
+		template<node_key<N> K>
+		[[nodiscard]] auto find_node(K const& key) const -> node_iterator {
+			auto const n = std::lower_bound(nodes_.cbegin(), nodes_.cend(), key, node_comparator{});
+			if (n == nodes_.cend() || key < *n->value) {
+				return nodes_.cend();
+			}
+			return n;
+		}
+
+		[[nodiscard]] auto value(node_iterator n) const -> N const& {
+			return *n->value;
+		}
+
+		[[nodiscard]] auto edge_begin(node_iterator n) const -> edge_iterator {
+			return n->edges.cbegin();
+		}
+
+		[[nodiscard]] auto edge_end(node_iterator n) const -> edge_iterator {
+			return n->edges.cend();
+		}
+
+		[[nodiscard]] auto destination(edge_iterator e) const -> N const& {
+			return *e->to;
+		}
+
+		[[nodiscard]] auto weight(edge_iterator e) const -> E const& {
+			return e->weight;
+		}
+
+		[[nodiscard]] auto edges_to(node_iterator src, node_iterator dst) const
+		   -> std::pair<edge_iterator, edge_iterator> {
+			return std::equal_range(src->edges.cbegin(), src->edges.cend(), *dst->value, edge_comparator{});
+		}
+
+		[[nodiscard]] auto find_edge(node_iterator src, node_iterator dst, E const& weight) const
+		   -> edge_iterator {
+			auto const key = edge{dst->value.get(), weight};
+			auto const e = std::lower_bound(src->edges.cbegin(), src->edges.cend(), key, edge_comparator{});
+			if (e == src->edges.cend() || edge_comparator{}(key, *e)) {
+				return src->edges.cend();
+			}
+			return e;
+		}
+
+		auto insert_node(N const& value) -> bool {
+			auto const n = std::lower_bound(nodes_.begin(), nodes_.end(), value, node_comparator{});
+			if (n != nodes_.end() && !(value < *n->value)) {
+				return false;
+			}
+			nodes_.insert(n, node{std::make_unique<N>(value), {}});
+			return true;
+		}
+
+		auto insert_edge(node_iterator src, node_iterator dst, E const& weight) -> bool {
+			auto& edges = mutable_node(src).edges;
+			auto const key = edge{dst->value.get(), weight};
+			auto const e = std::lower_bound(edges.begin(), edges.end(), key, edge_comparator{});
+			if (e != edges.end() && !edge_comparator{}(key, *e)) {
+				return false;
+			}
+			edges.insert(e, key);
+			return true;
+		}
+
+		auto append_node(N const& value) -> void {
+			nodes_.push_back(node{std::make_unique<N>(value), {}});
+		}
+
+		auto append_edge(node_iterator src, node_iterator dst, E const& weight) -> void {
+			mutable_node(src).edges.push_back(edge{dst->value.get(), weight});
+		}
+
+		auto erase_edge(node_iterator src, edge_iterator e) -> edge_iterator {
+			return mutable_node(src).edges.erase(e);
+		}
+
+		// Removes the node together with all of its incoming and outgoing edges.
+		auto erase_node(node_iterator n) -> void {
+			auto const& erased = *n->value;
+			for (auto& src : nodes_) {
+				auto const [first, last] =
+				   std::equal_range(src.edges.begin(), src.edges.end(), erased, edge_comparator{});
+				src.edges.erase(first, last);
+			}
+			nodes_.erase(n);
+		}
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+		}
+
+	private:
+		std::vector<node> nodes_;
+
+		auto mutable_node(node_iterator n) -> node& {
+			return nodes_[static_cast<std::size_t>(n - nodes_.cbegin())];
+		}
+	};
+
+	template<typename N, typename E>
+	class hash_storage::storage {
+		struct edge {
+			N const* to;
+			[[no_unique_address]] E weight;
+		};
+
+		struct node_data {
+			std::size_t rank;
+			std::vector<edge> edges;
+		};
+
+		// String-like nodes are hashed as std::string_view, so any string-like key finds them without
+		// building an N. Other node types can only be hashed, and so found, as N.
+		struct node_hash {
+			using is_transparent = void;
+
+			template<typename K>
+			auto operator()(K const& key) const -> std::size_t {
+				if constexpr (detail::string_like<N>) {
+					return std::hash<std::string_view>{}(std::string_view(key));
+				}
+				else {
+					return std::hash<N>{}(key);
+				}
+			}
+		};
+
+		using index_type = std::unordered_map<N, node_data, node_hash, std::equal_to<>>;
+		using entry = typename index_type::value_type;
+
+		struct edge_comparator {
+			auto operator()(edge const& lhs, edge const& rhs) const -> bool {
+				if constexpr (std::is_same_v<E, detail::no_weight>) {
+					return *lhs.to < *rhs.to;
+				}
+				else {
+					if (*lhs.to == *rhs.to) {
+						return lhs.weight < rhs.weight;
+					}
+					return *lhs.to < *rhs.to;
+				}
+			}
+
+			auto operator()(edge const& lhs, N const& rhs) const -> bool {
+				return *lhs.to < rhs;
+			}
+
+			auto operator()(N const& lhs, edge const& rhs) const -> bool {
+				return lhs < *rhs.to;
+			}
+		};
+
+	public:
+		using node_iterator = typename std::vector<entry*>::const_iterator;
+		using edge_iterator = typename std::vector<edge>::const_iterator;
+
+		storage() = default;
+
+		storage(storage const& other) {
+			index_.reserve(other.index_.size());
+			order_.reserve(other.order_.size());
+			for (auto const* other_entry : other.order_) {
+				auto const [it, inserted] =
+				   index_.try_emplace(other_entry->first, node_data{order_.size(), {}});
+				order_.push_back(&*it);
+			}
+
+			// edges must point at this storage's copies of the nodes
+			for (auto i = std::size_t{0}; i < order_.size(); ++i) {
+				auto& edges = order_[i]->second.edges;
+				edges.reserve(other.order_[i]->second.edges.size());
+				for (auto const& other_edge : other.order_[i]->second.edges) {
+					edges.push_back(edge{&index_.find(*other_edge.to)->first, other_edge.weight});
+				}
+			}
+		}
+
+		storage(storage&&) noexcept = default;
+
+		auto operator=(storage const& other) -> storage& {
+			auto copy = other;
+			std::swap(*this, copy);
+			return *this;
+		}
+
+		auto operator=(storage&&) noexcept -> storage& = default;
+
+		~storage() = default;
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return order_.empty();
+		}
+
+		[[nodiscard]] auto node_begin() const noexcept -> node_iterator {
+			return order_.cbegin();
+		}
+
+		[[nodiscard]] auto node_end() const noexcept -> node_iterator {
+			return order_.cend();
+		}
+
+		template<typename K>
+		requires std::same_as<K, N> || (detail::string_like<N> && detail::string_like<K>)
+		[[nodiscard]] auto find_node(K const& key) const -> node_iterator {
+			auto const it = index_.find(key);
+			if (it == index_.end()) {
+				return order_.cend();
+			}
+			return order_.cbegin() + static_cast<std::ptrdiff_t>(it->second.rank);
+		}
+
+		[[nodiscard]] auto value(node_iterator n) const -> N const& {
+			return (*n)->first;
+		}
+
+		[[nodiscard]] auto edge_begin(node_iterator n) const -> edge_iterator {
+			return (*n)->second.edges.cbegin();
+		}
+
+		[[nodiscard]] auto edge_end(node_iterator n) const -> edge_iterator {
+			return (*n)->second.edges.cend();
+		}
+
+		[[nodiscard]] auto destination(edge_iterator e) const -> N const& {
+			return *e->to;
+		}
+
+		[[nodiscard]] auto weight(edge_iterator e) const -> E const& {
+			return e->weight;
+		}
+
+		[[nodiscard]] auto edges_to(node_iterator src, node_iterator dst) const
+		   -> std::pair<edge_iterator, edge_iterator> {
+			auto const& edges = (*src)->second.edges;
+			return std::equal_range(edges.cbegin(), edges.cend(), (*dst)->first, edge_comparator{});
+		}
+
+		[[nodiscard]] auto find_edge(node_iterator src, node_iterator dst, E const& weight) const
+		   -> edge_iterator {
+			auto const& edges = (*src)->second.edges;
+			auto const key = edge{&(*dst)->first, weight};
+			auto const e = std::lower_bound(edges.cbegin(), edges.cend(), key, edge_comparator{});
+			if (e == edges.cend() || edge_comparator{}(key, *e)) {
+				return edges.cend();
+			}
+			return e;
+		}
+
+		auto insert_node(N const& value) -> bool {
+			auto const [it, inserted] = index_.try_emplace(value, node_data{0, {}});
+			if (!inserted) {
+				return false;
+			}
+
+			auto const position =
+			   std::upper_bound(order_.begin(), order_.end(), value, [](N const& lhs, entry const* rhs) {
+				   return lhs < rhs->first;
+			   });
+			renumber(order_.insert(position, &*it));
+			return true;
+		}
+
+		auto insert_edge(node_iterator src, node_iterator dst, E const& weight) -> bool {
+			auto& edges = (*src)->second.edges;
+			auto const key = edge{&(*dst)->first, weight};
+			auto const e = std::lower_bound(edges.begin(), edges.end(), key, edge_comparator{});
+			if (e != edges.end() && !edge_comparator{}(key, *e)) {
+				return false;
+			}
+			edges.insert(e, key);
+			return true;
+		}
+
+		auto append_node(N const& value) -> void {
+			auto const it = index_.try_emplace(value, node_data{order_.size(), {}}).first;
+			order_.push_back(&*it);
+		}
+
+		auto append_edge(node_iterator src, node_iterator dst, E const& weight) -> void {
+			(*src)->second.edges.push_back(edge{&(*dst)->first, weight});
+		}
+
+		auto erase_edge(node_iterator src, edge_iterator e) -> edge_iterator {
+			return (*src)->second.edges.erase(e);
+		}
+
+		// Removes the node together with all of its incoming and outgoing edges.
+		auto erase_node(node_iterator n) -> void {
+			auto const& erased = (*n)->first;
+			for (auto* src : order_) {
+				auto& edges = src->second.edges;
+				auto const [first, last] =
+				   std::equal_range(edges.begin(), edges.end(), erased, edge_comparator{});
+				edges.erase(first, last);
+			}
+
+			auto const index_it = index_.find(erased);
+			renumber(order_.erase(n));
+			index_.erase(index_it);
+		}
+
+		auto clear() noexcept -> void {
+			index_.clear();
+			order_.clear();
+		}
+
+	private:
+		// Elements of an unordered_map never move, so order_ and edges can point into it.
+		index_type index_;
+		std::vector<entry*> order_;
+
+		auto renumber(typename std::vector<entry*>::iterator first) -> void {
+			for (; first != order_.end(); ++first) {
+				(*first)->second.rank = static_cast<std::size_t>(first - order_.begin());
+			}
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_STORAGE_HPP
@@ -0,0 +1,186 @@
+#ifndef GDWG_THREAD_POOL_HPP
+#define GDWG_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A fixed set of worker threads shared by the parallel graph algorithms.
+	//
+	// Work is submitted as an index range that is cut into chunks, which the workers and the
+	// calling thread claim until none are left; the call returns once every chunk has run. Each
+	// chunk is told which thread runs it, a number in [0, size()), so callers can keep per-thread
+	// scratch space without locking. If a chunk throws, the remaining chunks are skipped and the
+	// first exception is rethrown to the caller.
+	//
+	// Calls from several threads are run one at a time. A chunk must not submit work to the pool
+	// running it.
+	class thread_pool {
+	public:
+		// threads counts the calling thread, so thread_pool(1) starts no workers at all.
+		explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency()) {
+			threads = std::max(threads, std::size_t{1});
+			workers_.reserve(threads - 1);
+			for (auto index = std::size_t{1}; index < threads; ++index) {
+				workers_.emplace_back([this, index] { work(index); });
+			}
+		}
+
+		thread_pool(thread_pool const&) = delete;
+		auto operator=(thread_pool const&) -> thread_pool& = delete;
+
+		~thread_pool() {
+			{
+				auto const lock = std::scoped_lock(mutex_);
+				stopping_ = true;
+			}
+			wake_.notify_all();
+			for (auto& worker : workers_) {
+				worker.join();
+			}
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return workers_.size() + 1;
+		}
+
+		// Calls fn(first, last, thread) on consecutive chunks of at most grain indices that
+		// together cover [0, count).
+		template<typename F>
+		auto for_each_chunk(std::size_t count, std::size_t grain, F&& fn) -> void {
+			grain = std::max(grain, std::size_t{1});
+			auto const chunks = (count + grain - 1) / grain;
+			if (chunks == 0) {
+				return;
+			}
+			if (chunks == 1 || workers_.empty()) {
+				for (auto first = std::size_t{0}; first < count; first += grain) {
+					fn(first, std::min(first + grain, count), std::size_t{0});
+				}
+				return;
+			}
+
+			auto const submit_lock = std::scoped_lock(submit_mutex_);
+			{
+				auto const lock = std::scoped_lock(mutex_);
+				job_ = job{const_cast<void*>(static_cast<void const*>(std::addressof(fn))),
+				           &invoke<F>,
+				           count,
+				           grain,
+				           chunks};
+				next_chunk_.store(0, std::memory_order_relaxed);
+				error_ = nullptr;
+				busy_ = workers_.size();
+				++generation_;
+			}
+			wake_.notify_all();
+
+			run_chunks(0);
+
+			auto lock = std::unique_lock(mutex_);
+			done_.wait(lock, [this] { return busy_ == 0; });
+			if (error_) {
+				std::rethrow_exception(std::exchange(error_, nullptr));
+			}
+		}
+
+		// Calls fn(index, thread) for every index in [0, count).
+		template<typename F>
+		auto for_each_index(std::size_t count, F&& fn) -> void {
+			for_each_chunk(count, default_grain(count), [&fn](auto first, auto last, auto thread) {
+				for (; first < last; ++first) {
+					fn(first, thread);
+				}
+			});
+		}
+
+		// A grain that gives each thread several chunks, so uneven chunks still balance out.
+		[[nodiscard]] auto default_grain(std::size_t count) const noexcept -> std::size_t {
+			return std::max(count / (8 * size()), std::size_t{1});
+		}
+
+	private:
+		struct job {
+			void* fn = nullptr;
+			void (*invoke)(void*, std::size_t, std::size_t, std::size_t) = nullptr;
+			std::size_t count = 0;
+			std::size_t grain = 1;
+			std::size_t chunks = 0;
+		};
+
+		std::vector<std::thread> workers_;
+		std::mutex submit_mutex_;
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		std::condition_variable done_;
+		job job_;
+		std::atomic<std::size_t> next_chunk_ = 0;
+		std::exception_ptr error_;
+		std::size_t busy_ = 0;
+		std::size_t generation_ = 0;
+		bool stopping_ = false;
+
+		template<typename F>
+		static auto invoke(void* fn, std::size_t first, std::size_t last, std::size_t thread)
+		   -> void {
+			(*static_cast<std::remove_reference_t<F>*>(fn))(first, last, thread);
+		}
+
+		auto run_chunks(std::size_t thread) -> void {
+			for (;;) {
+				auto const chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+				if (chunk >= job_.chunks) {
+					return;
+				}
+				auto const first = chunk * job_.grain;
+				try {
+					job_.invoke(job_.fn, first, std::min(first + job_.grain, job_.count), thread);
+				} catch (...) {
+					next_chunk_.store(job_.chunks, std::memory_order_relaxed);
+					auto const lock = std::scoped_lock(mutex_);
+					if (!error_) {
+						error_ = std::current_exception();
+					}
+				}
+			}
+		}
+
+		auto work(std::size_t thread) -> void {
+			auto seen = std::size_t{0};
+			for (;;) {
+				{
+					auto lock = std::unique_lock(mutex_);
+					wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+					if (stopping_) {
+						return;
+					}
+					seen = generation_;
+				}
+
+				run_chunks(thread);
+
+				auto const lock = std::scoped_lock(mutex_);
+				if (--busy_ == 0) {
+					done_.notify_one();
+				}
+			}
+		}
+	};
+
+	// The pool used by algorithms that are not given one, sized to the hardware.
+	inline auto default_thread_pool() -> thread_pool& {
+		static auto pool = thread_pool();
+		return pool;
+	}
+} // namespace gdwg
+
+#endif // GDWG_THREAD_POOL_HPP
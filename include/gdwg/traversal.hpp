@@ -0,0 +1,339 @@
+#ifndef GDWG_TRAVERSAL_HPP
+#define GDWG_TRAVERSAL_HPP
+
+#include <gdwg/frozen_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Unweighted traversals. Like the shortest-path algorithms, they run on a gdwg::frozen_graph and
+// report results by node rank, i.e. aligned with graph::nodes(); edge weights are ignored.
+namespace gdwg {
+	// The result of a breadth-first search.
+	struct bfs_tree {
+		// Hops from the source, or unreachable<std::size_t> for nodes that were not reached.
+		std::vector<std::size_t> depth;
+		// The node a node was discovered from, or no_rank for the source and unreached nodes.
+		std::vector<std::size_t> parent;
+
+		[[nodiscard]] auto reached(std::size_t rank) const -> bool {
+			return depth[rank] != unreachable<std::size_t>;
+		}
+	};
+
+	namespace detail {
+		using word_type = std::uint64_t;
+		inline constexpr auto word_bits = std::size_t{64};
+
+		// A set of node ranks, one bit each, that threads can add to concurrently.
+		class node_bitmap {
+		public:
+			explicit node_bitmap(std::size_t size)
+			: words_((size + word_bits - 1) / word_bits) {}
+
+			[[nodiscard]] auto word_count() const noexcept -> std::size_t {
+				return words_.size();
+			}
+
+			[[nodiscard]] auto word(std::size_t index) const -> word_type {
+				return words_[index].load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] auto contains(std::size_t rank) const -> bool {
+				return ((word(rank / word_bits) >> (rank % word_bits)) & 1U) != 0;
+			}
+
+			// Adds rank, returning whether it was absent.
+			auto insert(std::size_t rank) -> bool {
+				auto const bit = word_type{1} << (rank % word_bits);
+				return (words_[rank / word_bits].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+			}
+
+			auto clear() -> void {
+				for (auto& word : words_) {
+					word.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			auto swap(node_bitmap& other) noexcept -> void {
+				words_.swap(other.words_);
+			}
+
+		private:
+			std::vector<std::atomic<word_type>> words_;
+		};
+
+		// Calls fn(rank) for every rank in the given word of bitmap.
+		template<typename F>
+		auto for_each_in_word(node_bitmap const& bitmap, std::size_t index, F&& fn) -> void {
+			for (auto bits = bitmap.word(index); bits != 0; bits &= bits - 1) {
+				fn(index * word_bits + static_cast<std::size_t>(std::countr_zero(bits)));
+			}
+		}
+
+		// Searches from up to word_bits sources at once, bit i of a node's words standing for
+		// batch[i], and writes the hop counts of source i into depths[i].
+		template<typename N, typename E>
+		auto multi_source_bfs(frozen_graph<N, E> const& g,
+		                      std::span<std::size_t const> batch,
+		                      std::span<std::vector<std::size_t>> depths,
+		                      std::size_t max_depth,
+		                      thread_pool& pool) -> void {
+			// Pull from in-edges once the frontier's out-edges exceed 1/alpha of all edges.
+			constexpr auto alpha = std::size_t{14};
+
+			auto const all = batch.size() == word_bits ? ~word_type{0}
+			                                           : (word_type{1} << batch.size()) - 1;
+			auto seen = std::vector<word_type>(g.size());
+			auto visit = std::vector<word_type>(g.size());
+			auto next = std::vector<std::atomic<word_type>>(g.size());
+			auto frontier = std::vector<std::size_t>{};
+			auto frontier_edges = std::size_t{0};
+			for (auto i = std::size_t{0}; i < batch.size(); ++i) {
+				auto const rank = batch[i];
+				if (visit[rank] == 0) {
+					frontier.push_back(rank);
+					frontier_edges += g.out_degree(rank);
+				}
+				seen[rank] |= word_type{1} << i;
+				visit[rank] |= word_type{1} << i;
+				depths[i][rank] = 0;
+			}
+
+			// nodes whose next word went from empty to non-empty, gathered per thread
+			auto touched = std::vector<std::vector<std::size_t>>(pool.size());
+			auto edges = std::vector<std::size_t>(pool.size());
+			for (auto depth = std::size_t{1}; !frontier.empty() && depth <= max_depth; ++depth) {
+				if (frontier_edges > g.edge_count() / alpha) {
+					pool.for_each_chunk(
+					   g.size(),
+					   pool.default_grain(g.size()),
+					   [&](std::size_t first, std::size_t last, std::size_t thread) {
+						   for (; first < last; ++first) {
+							   if (seen[first] == all) {
+								   continue;
+							   }
+							   auto found = word_type{0};
+							   for (auto const from : g.in_neighbours(first)) {
+								   found |= visit[from];
+								   if ((found | seen[first]) == all) {
+									   break;
+								   }
+							   }
+							   found &= ~seen[first];
+							   if (found != 0) {
+								   next[first].store(found, std::memory_order_relaxed);
+								   touched[thread].push_back(first);
+							   }
+						   }
+					   });
+				}
+				else {
+					pool.for_each_index(frontier.size(), [&](std::size_t index, std::size_t thread) {
+						auto const from = frontier[index];
+						for (auto const to : g.out_neighbours(from)) {
+							auto const found = visit[from] & ~seen[to];
+							if (found != 0
+							    && next[to].fetch_or(found, std::memory_order_relaxed) == 0) {
+								touched[thread].push_back(to);
+							}
+						}
+					});
+				}
+
+				for (auto const rank : frontier) {
+					visit[rank] = 0;
+				}
+				frontier.clear();
+				for (auto& nodes : touched) {
+					frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+					nodes.clear();
+				}
+
+				// every frontier node is distinct, so each thread owns the words it updates
+				pool.for_each_index(frontier.size(), [&](std::size_t index, std::size_t thread) {
+					auto const rank = frontier[index];
+					auto const found = next[rank].exchange(0, std::memory_order_relaxed);
+					visit[rank] = found;
+					seen[rank] |= found;
+					for (auto bits = found; bits != 0; bits &= bits - 1) {
+						depths[static_cast<std::size_t>(std::countr_zero(bits))][rank] = depth;
+					}
+					edges[thread] += g.out_degree(rank);
+				});
+				frontier_edges = 0;
+				for (auto& count : edges) {
+					frontier_edges += std::exchange(count, 0);
+				}
+			}
+		}
+	} // namespace detail
+
+	// Breadth-first search from src, one level at a time across pool. Each level either expands
+	// the frontier's out-edges (top-down) or has every unvisited node scan its in-edges for a
+	// parent in the frontier (bottom-up), whichever is expected to touch fewer edges (Beamer,
+	// Asanovic and Patterson). Frontiers are bitmaps, so neither direction allocates per node.
+	template<typename N, typename E, node_key<N> K>
+	auto bfs(frozen_graph<N, E> const& g, K const& src, thread_pool& pool = default_thread_pool())
+	   -> bfs_tree {
+		auto const source = g.rank(src);
+		if (source == no_rank) {
+			throw std::runtime_error("Cannot call gdwg::bfs if src doesn't exist in the graph");
+		}
+
+		// Switch to bottom-up once the frontier's edges exceed 1/alpha of the edges still to be
+		// explored, and back once the frontier holds under 1/beta of the nodes.
+		constexpr auto alpha = std::size_t{14};
+		constexpr auto beta = std::size_t{24};
+
+		auto result = bfs_tree{std::vector<std::size_t>(g.size(), unreachable<std::size_t>),
+		                       std::vector<std::size_t>(g.size(), no_rank)};
+		auto visited = detail::node_bitmap(g.size());
+		auto frontier = detail::node_bitmap(g.size());
+		auto next = detail::node_bitmap(g.size());
+		visited.insert(source);
+		frontier.insert(source);
+		result.depth[source] = 0;
+
+		struct level_stats {
+			std::size_t nodes = 0;
+			std::size_t edges = 0;
+		};
+		auto stats = std::vector<level_stats>(pool.size());
+		auto frontier_nodes = std::size_t{1};
+		auto frontier_edges = g.out_degree(source);
+		auto unexplored_edges = g.edge_count() - frontier_edges;
+		auto bottom_up = false;
+
+		for (auto depth = std::size_t{1}; frontier_nodes > 0; ++depth) {
+			if (!bottom_up && frontier_edges > unexplored_edges / alpha) {
+				bottom_up = true;
+			}
+			else if (bottom_up && frontier_nodes < g.size() / beta) {
+				bottom_up = false;
+			}
+
+			auto const discover = [&](std::size_t rank, std::size_t parent, level_stats& level) {
+				result.depth[rank] = depth;
+				result.parent[rank] = parent;
+				++level.nodes;
+				level.edges += g.out_degree(rank);
+			};
+
+			auto const words = frontier.word_count();
+			auto const grain = pool.default_grain(words);
+			if (bottom_up) {
+				// each chunk owns whole words, so only its thread writes those nodes
+				pool.for_each_chunk(words, grain, [&](auto first, auto last, auto thread) {
+					auto& level = stats[thread];
+					for (auto rank = first * detail::word_bits;
+					     rank < std::min(last * detail::word_bits, g.size());
+					     ++rank)
+					{
+						if (visited.contains(rank)) {
+							continue;
+						}
+						for (auto const parent : g.in_neighbours(rank)) {
+							if (frontier.contains(parent)) {
+								visited.insert(rank);
+								next.insert(rank);
+								discover(rank, parent, level);
+								break;
+							}
+						}
+					}
+				});
+			}
+			else {
+				pool.for_each_chunk(words, grain, [&](auto first, auto last, auto thread) {
+					auto& level = stats[thread];
+					for (; first < last; ++first) {
+						detail::for_each_in_word(frontier, first, [&](std::size_t parent) {
+							for (auto const rank : g.out_neighbours(parent)) {
+								if (!visited.contains(rank) && visited.insert(rank)) {
+									next.insert(rank);
+									discover(rank, parent, level);
+								}
+							}
+						});
+					}
+				});
+			}
+
+			frontier_nodes = 0;
+			frontier_edges = 0;
+			for (auto& level : stats) {
+				frontier_nodes += level.nodes;
+				frontier_edges += level.edges;
+				level = level_stats{};
+			}
+			unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+			frontier.swap(next);
+			next.clear();
+		}
+		return result;
+	}
+
+	template<typename N, typename E, typename Storage, node_key<N> K>
+	auto bfs(graph<N, E, Storage> const& g, K const& src, thread_pool& pool = default_thread_pool())
+	   -> bfs_tree {
+		return bfs(frozen_graph<N, E>(g), src, pool);
+	}
+
+	// Hop counts from every node in sources, found word_bits (64) sources at a time: each node
+	// keeps one bit per source in the batch, so a single scan of an edge list advances every
+	// search in the batch that has reached it (Then et al.). depths[i][rank] is the hop count from
+	// the i-th source, or unreachable<std::size_t> if it is more than max_depth hops away or not
+	// reachable at all. Levels are expanded in parallel on pool.
+	template<typename N, typename E, std::ranges::input_range R>
+	requires node_key<std::ranges::range_value_t<R>, N>
+	auto multi_source_bfs(frozen_graph<N, E> const& g,
+	                      R const& sources,
+	                      std::size_t max_depth = unreachable<std::size_t>,
+	                      thread_pool& pool = default_thread_pool())
+	   -> std::vector<std::vector<std::size_t>> {
+		auto ranks = std::vector<std::size_t>{};
+		for (auto const& src : sources) {
+			ranks.push_back(g.rank(src));
+			if (ranks.back() == no_rank) {
+				throw std::runtime_error("Cannot call gdwg::multi_source_bfs if a source doesn't "
+				                         "exist in the graph");
+			}
+		}
+
+		auto depths = std::vector<std::vector<std::size_t>>(
+		   ranks.size(),
+		   std::vector<std::size_t>(g.size(), unreachable<std::size_t>));
+		for (auto first = std::size_t{0}; first < ranks.size(); first += detail::word_bits) {
+			auto const count = std::min(detail::word_bits, ranks.size() - first);
+			detail::multi_source_bfs(g,
+			                         std::span<std::size_t const>(ranks).subspan(first, count),
+			                         std::span(depths).subspan(first, count),
+			                         max_depth,
+			                         pool);
+		}
+		return depths;
+	}
+
+	template<typename N, typename E, typename Storage, std::ranges::input_range R>
+	requires node_key<std::ranges::range_value_t<R>, N>
+	auto multi_source_bfs(graph<N, E, Storage> const& g,
+	                      R const& sources,
+	                      std::size_t max_depth = unreachable<std::size_t>,
+	                      thread_pool& pool = default_thread_pool())
+	   -> std::vector<std::vector<std::size_t>> {
+		return multi_source_bfs(frozen_graph<N, E>(g), sources, max_depth, pool);
+	}
+} // namespace gdwg
+
+#endif // GDWG_TRAVERSAL_HPP
@@ -0,0 +1,6 @@
+#include "gdwg/graph.hpp"
+
+#include <string>
+
+GDWG_GRAPH_INSTANTIATE(, std::string, int);
+GDWG_GRAPH_INSTANTIATE(, int, int);
@@ -3,6 +3,26 @@
 // graph_test_3: Accessors tests
 // graph_test_4: Iterators tests
 // graph_test_5: Comparisons tests and extractors test
+// graph_test_6: Dense storage tests
+// graph_test_7: Unweighted graph tests
+// graph_test_8: Storage policy tests
+// graph_test_9: Heterogeneous lookup tests
+// graph_test_10: Frozen graph and Dijkstra tests
+// graph_test_11: Thread pool and delta-stepping tests
+// graph_test_12: Breadth-first search tests
+// graph_test_13: PageRank tests
+// graph_test_14: Connected components tests
+// graph_test_15: Incremental topological order tests
+// graph_test_16: Graph observer and reachability index tests
+// graph_test_17: Triangle and common neighbour tests
+// graph_test_18: Minimum spanning forest tests
+// graph_test_19: All pairs shortest paths tests
+// graph_test_20: Contraction hierarchy tests
+// graph_test_21: A* and landmark tests
+// graph_test_22: K shortest paths tests
+// graph_test_23: Maximum flow tests
+// graph_test_24: Betweenness centrality tests
+// graph_test_25: Random walk tests
 
 // ############## Constructors test ##############
 // graph() test: test empty graph.
@@ -44,6 +64,9 @@
 // weights: Check all weights from src to dst
 // find: Check the the iterator returned by find function
 // connections: Check all dst from src
+// induced_subgraph: Check the nodes and edges kept from a subset,
+// both packed closely and spread across the whole range of int
+// transpose: Check every edge is reversed with its weight
 
 // ############## Iterator test ##############
 // iterator begin/end: test value_type of begin/end iterator
@@ -53,6 +76,138 @@
 // Comparison test: test two graphs with the same nodes and edges.
 // Exractors test: test output string of graph.
 
+// ############## Dense storage test ##############
+// Check the public API behaves the same with gdwg::dense_storage:
+// node order (including negative and extreme values), iteration
+// order in both directions against the tree storage, accessors,
+// erase/replace/merge, erasing through iterators, copy and move.
+// Check node values too far apart to index are rejected.
+
+// ############## Unweighted graph test ##############
+// graph<N, void>: value_type holds only from and to. Edges are
+// inserted, found and erased by src and dst. Iteration, node
+// replacement/merging and the extractor work without weights.
+
+// ############## Storage policy test ##############
+// Run the same scenario against every built-in storage policy and
+// check nodes, edges, extractor output and ordering are identical.
+// Check induced subgraphs match erasing every other node, and
+// transposed graphs match inserting every edge reversed, with and
+// without the storage's append_node and append_edge.
+// Check user-provided policies are accepted or rejected by the
+// gdwg::graph_storage concept.
+
+// ############## Heterogeneous lookup test ##############
+// Look up std::string nodes by std::string_view and char const*
+// through every accessor and erase function, and check that no
+// std::string is constructed along the way. Check integer keys
+// wider than N are rejected instead of wrapping onto a node, and
+// that every storage rejects floating keys N cannot hold exactly.
+
+// ############## Frozen graph and Dijkstra test ##############
+// Check a frozen graph's ranks, degrees, out-edges and in-edges,
+// and that ranks of keys of other arithmetic types compare by value.
+// Check dijkstra and shortest_path distances, predecessors and
+// errors with every heap, including distances too long for an
+// integral weight, and compare all heaps against Bellman-Ford on
+// random graphs.
+
+// ############## Thread pool and delta-stepping test ##############
+// Check the thread pool runs every index once and forwards
+// exceptions. Check delta-stepping against hand-computed distances
+// and against dijkstra for several deltas and thread counts.
+
+// ############## Breadth-first search test ##############
+// Check bfs depths against a serial search on random graphs, on
+// graphs that switch to bottom-up and on a chain that never does.
+// Check every parent is one level up and has an edge to its child.
+// Check multi-source bfs against bfs across several batches, and
+// that max_depth cuts each search off after k hops.
+
+// ############## PageRank test ##############
+// Check pagerank on a cycle, with and without edge weights and with
+// a dangling node, against dense power iteration for several thread
+// counts, and that bad damping factors and weights are rejected.
+
+// ############## Connected components test ##############
+// Check strongly connected component ids follow a topological order
+// and match mutual reachability on random graphs, and that a chain
+// of 300000 nodes is handled without recursing. Check weakly
+// connected components against a serial flood fill for several
+// thread counts.
+
+// ############## Incremental topological order test ##############
+// Check a dag reorders nodes as edges go in, rejects edges that
+// would close a cycle without changing anything, and keeps its
+// order valid through random insertions, erasures and copies.
+// Check a cleared dag keeps nothing from earlier reorders.
+
+// ############## Graph observer and reachability index test ##############
+// Check graph observers hear about every successful change and
+// the graph's destruction. Check a reachability index against
+// fresh searches while nodes and edges are randomly inserted and
+// erased, and after its graph is gone.
+
+// ############## Triangle and common neighbour test ##############
+// Check triangles and common neighbours ignore edge direction,
+// parallel edges and self-loops, and agree with brute force on
+// random graphs with a hub, for several thread counts.
+
+// ############## Minimum spanning forest test ##############
+// Check the forest takes the lightest of parallel edges either
+// way round and never a self-loop, and that on random graphs
+// with many tied weights it spans every weakly connected
+// component with Kruskal's total weight, for several thread
+// counts.
+
+// ############## All pairs shortest paths test ##############
+// Check the distance matrix takes the lightest of parallel edges,
+// marks unreachable pairs, including those too far apart for an
+// integral weight, and rejects negative weights. Check it
+// against dijkstra from every node for sizes either side of whole
+// tiles, for several thread counts.
+
+// ############## Contraction hierarchy test ##############
+// Check contraction hierarchy queries take the lightest of
+// parallel edges, report unreachable nodes and reject missing
+// nodes and negative weights. Check them against dijkstra on a
+// grid of streets and on a random graph, including queries from
+// several threads at once.
+
+// ############## A* and landmark test ##############
+// Check astar with admissible heuristics, consistent or not, finds
+// shortest paths and rejects missing nodes and negative weights,
+// and that distances too long for E stay unreachable. Check
+// landmark bounds never exceed true distances, and that astar
+// with landmarks agrees with dijkstra, also once weights have
+// risen since the landmarks were built.
+
+// ############## K shortest paths test ##############
+// Check k_shortest_paths returns loopless paths in order of
+// length, counting parallel edges once, leaving out paths too
+// long for E, and rejecting missing nodes and negative weights.
+// Check the lengths against an exhaustive search of random graphs.
+
+// ############## Maximum flow test ##############
+// Check max_flow on a textbook network, fills parallel edges in
+// order, ignores self-loops and rejects bad arguments. Check its
+// value against Edmonds-Karp on random graphs, and that its edge
+// flows respect capacities and conservation, for integral and
+// floating point capacities.
+
+// ############## Betweenness centrality test ##############
+// Check betweenness_centrality on paths, stars and diamonds,
+// ignoring paths too long for E, and against the definition on random weighted and
+// unweighted graphs with one and several threads. Check sampled
+// sources are reproducible by seed and estimate the exact scores.
+
+// ############## Random walk test ##############
+// Check walk_sampler steps in proportion to edge weights, never
+// along zero-weight edges, and uniformly on unweighted graphs.
+// Check batches of walks follow edges, stop only at dead ends
+// and are the same for a seed whatever the thread pool, while
+// consecutive seeds do not just shift each other's walks.
+
 #include "gdwg/graph.hpp"
 
 #include <catch2/catch.hpp>
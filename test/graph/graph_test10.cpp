@@ -0,0 +1,161 @@
+#include "gdwg/shortest_paths.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST_CASE("frozen graph: ranks, degrees and adjacency in both directions") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("a", "b", 5);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("c", "a", 4);
+	g.insert_edge("c", "c", 0);
+
+	auto const frozen = gdwg::frozen_graph<std::string, int>(g);
+	CHECK(frozen.nodes() == g.nodes());
+	CHECK(frozen.size() == 4);
+	CHECK(frozen.edge_count() == 5);
+	CHECK(frozen.rank("c") == 2);
+	CHECK(frozen.rank(std::string("x")) == gdwg::no_rank);
+
+	auto const a = frozen.rank("a");
+	auto const c = frozen.rank("c");
+	CHECK(frozen.out_degree(a) == 3);
+	CHECK(frozen.in_degree(a) == 1);
+	CHECK(frozen.in_degree(frozen.rank("d")) == 0);
+
+	auto const neighbours = frozen.out_neighbours(a);
+	CHECK(std::vector<std::size_t>(neighbours.begin(), neighbours.end())
+	      == std::vector<std::size_t>{1, 1, 2});
+	auto const weights = frozen.out_weights(a);
+	CHECK(std::vector<int>(weights.begin(), weights.end()) == std::vector<int>{1, 5, 2});
+
+	auto const sources = frozen.in_neighbours(c);
+	CHECK(std::vector<std::size_t>(sources.begin(), sources.end()) == std::vector<std::size_t>{a, c});
+	for (auto const edge : frozen.in_edges(c)) {
+		CHECK(frozen.target(edge) == c);
+	}
+	CHECK(frozen.weight(frozen.in_edges(c)[0]) == 2);
+}
+
+TEST_CASE("frozen graph: ranks of keys of another arithmetic type") {
+	auto const g = gdwg::graph<int, void>{-3, -1, 2, 5};
+	auto const frozen = gdwg::frozen_graph<int, void>(g);
+	REQUIRE(g.is_node(2UL));
+	CHECK(frozen.rank(2UL) == 2);
+	CHECK(frozen.rank(-1L) == 1);
+	CHECK(frozen.rank(std::int8_t{5}) == 3);
+	CHECK(frozen.rank(-3.0) == 0);
+	// keys that would wrap or truncate onto a node find nothing
+	CHECK(frozen.rank(0xFFFF'FFFF'FFFF'FFFDUL) == gdwg::no_rank);
+	CHECK(frozen.rank(0x1'0000'0002L) == gdwg::no_rank);
+	CHECK(frozen.rank(2.5) == gdwg::no_rank);
+	CHECK(frozen.rank(3UL) == gdwg::no_rank);
+
+	auto const unsigned_graph = gdwg::graph<unsigned, void>{0U, 4U};
+	CHECK(gdwg::frozen_graph<unsigned, void>(unsigned_graph).rank(-4) == gdwg::no_rank);
+	CHECK(gdwg::frozen_graph<unsigned, void>(unsigned_graph).rank(4L) == 1);
+}
+
+TEMPLATE_TEST_CASE("dijkstra: distances and predecessors by rank",
+                   "",
+                   gdwg::binary_heap,
+                   gdwg::pairing_heap,
+                   gdwg::radix_heap) {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 7);
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "b", 2);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("d", "a", 1);
+	g.insert_edge("e", "a", 1);
+
+	auto const paths = gdwg::dijkstra<TestType>(g, "a");
+	CHECK(paths.distance == std::vector<int>{0, 3, 1, 4, gdwg::unreachable<int>});
+	CHECK(paths.predecessor == std::vector<std::size_t>{gdwg::no_rank, 2, 0, 1, gdwg::no_rank});
+	CHECK(paths.reached(3));
+	CHECK(!paths.reached(4));
+	CHECK(paths.path_to(3) == std::vector<std::size_t>{0, 2, 1, 3});
+	CHECK(paths.path_to(4).empty());
+
+	auto const frozen = gdwg::frozen_graph<std::string, int>(g);
+	auto const to_d = gdwg::shortest_path<TestType>(frozen, "a", "d");
+	CHECK(to_d.distance[frozen.rank("d")] == 4);
+	CHECK(to_d.path_to(frozen.rank("d")) == paths.path_to(3));
+}
+
+TEMPLATE_TEST_CASE("dijkstra: distances too long for E are unreachable",
+                   "",
+                   gdwg::binary_heap,
+                   gdwg::pairing_heap,
+                   gdwg::radix_heap) {
+	constexpr auto most = std::numeric_limits<int>::max();
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3};
+	g.insert_edge(0, 1, most - 10);
+	g.insert_edge(1, 2, 20);
+	g.insert_edge(1, 3, 5);
+
+	auto const paths = gdwg::dijkstra<TestType>(g, 0);
+	CHECK(paths.distance == std::vector<int>{0, most - 10, gdwg::unreachable<int>, most - 5});
+	CHECK(!paths.reached(2));
+	CHECK(paths.predecessor[2] == gdwg::no_rank);
+	// the same as the matrix of all pairs, which saturates alike
+	auto const all_pairs = gdwg::all_pairs_shortest_paths(g);
+	for (auto to = std::size_t{0}; to < 4; ++to) {
+		CHECK(paths.distance[to] == all_pairs(0, to));
+	}
+}
+
+TEST_CASE("dijkstra: missing nodes and negative weights are rejected") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	g.insert_edge(1, 2, -1);
+
+	REQUIRE_THROWS_WITH(gdwg::dijkstra(g, 3),
+	                    "Cannot call gdwg::dijkstra if src doesn't exist in the graph");
+	REQUIRE_THROWS_WITH(gdwg::shortest_path(g, 1, 3),
+	                    "Cannot call gdwg::shortest_path if src or dst node don't exist in the "
+	                    "graph");
+	REQUIRE_THROWS_WITH(gdwg::dijkstra(g, 1),
+	                    "Cannot call gdwg::dijkstra on a graph with negative edge weights");
+	CHECK(gdwg::dijkstra(g, 2).distance == std::vector<int>{gdwg::unreachable<int>, 0});
+}
+
+TEST_CASE("dijkstra: floating point weights use infinity for unreachable nodes") {
+	auto g = gdwg::graph<int, double>{1, 2, 3};
+	g.insert_edge(1, 2, 0.5);
+	g.insert_edge(2, 1, 0.25);
+
+	auto const paths = gdwg::dijkstra<gdwg::pairing_heap>(g, 2);
+	CHECK(paths.distance[0] == 0.25);
+	CHECK(paths.distance[2] == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("dijkstra: every heap agrees with Bellman-Ford on random graphs") {
+	for (auto round = 0u; round < 20; ++round) {
+		auto const node_count = 60;
+		auto const g = gdwg_test::random_graph(node_count, 4 * node_count, round, 0u, 50u);
+
+		auto expected = std::vector<unsigned>(node_count, gdwg::unreachable<unsigned>);
+		expected[0] = 0;
+		for (auto pass = 0; pass < node_count; ++pass) {
+			for (auto const& [from, to, w] : g) {
+				auto const f = static_cast<std::size_t>(from);
+				auto const t = static_cast<std::size_t>(to);
+				if (expected[f] != gdwg::unreachable<unsigned> && expected[f] + w < expected[t]) {
+					expected[t] = expected[f] + w;
+				}
+			}
+		}
+
+		auto const frozen = gdwg::frozen_graph<int, unsigned>(g);
+		CHECK(gdwg::dijkstra<gdwg::binary_heap>(frozen, 0).distance == expected);
+		CHECK(gdwg::dijkstra<gdwg::pairing_heap>(frozen, 0).distance == expected);
+		CHECK(gdwg::dijkstra<gdwg::radix_heap>(frozen, 0).distance == expected);
+	}
+}
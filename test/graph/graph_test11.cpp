@@ -0,0 +1,88 @@
+#include "gdwg/shortest_paths.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("thread pool: chunks cover every index exactly once") {
+	for (auto const threads : {1, 2, 4}) {
+		auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+		CHECK(pool.size() == static_cast<std::size_t>(threads));
+
+		auto hits = std::vector<std::atomic<int>>(1000);
+		auto thread_ok = std::atomic<bool>(true);
+		pool.for_each_chunk(hits.size(), 7, [&](std::size_t first, std::size_t last, std::size_t thread) {
+			if (thread >= pool.size() || last - first > 7) {
+				thread_ok = false;
+			}
+			for (; first < last; ++first) {
+				++hits[first];
+			}
+		});
+		CHECK(thread_ok);
+		for (auto const& hit : hits) {
+			CHECK(hit == 1);
+		}
+
+		auto sum = std::atomic<std::size_t>(0);
+		pool.for_each_index(100, [&](std::size_t index, std::size_t) { sum += index; });
+		CHECK(sum == 4950);
+		pool.for_each_index(0, [](std::size_t, std::size_t) { FAIL("no indices to visit"); });
+	}
+}
+
+TEST_CASE("thread pool: the first exception reaches the caller") {
+	auto pool = gdwg::thread_pool(3);
+	REQUIRE_THROWS_WITH(pool.for_each_index(500,
+	                                        [](std::size_t index, std::size_t) {
+		                                        if (index == 123) {
+			                                        throw std::runtime_error("chunk failed");
+		                                        }
+	                                        }),
+	                    "chunk failed");
+
+	// the pool is still usable afterwards
+	auto count = std::atomic<int>(0);
+	pool.for_each_index(64, [&](std::size_t, std::size_t) { ++count; });
+	CHECK(count == 64);
+}
+
+TEST_CASE("delta-stepping: small graph with light and heavy edges") {
+	auto g = gdwg::graph<char, int>{'a', 'b', 'c', 'd', 'e'};
+	g.insert_edge('a', 'b', 10);
+	g.insert_edge('a', 'c', 1);
+	g.insert_edge('c', 'b', 1);
+	g.insert_edge('b', 'd', 0);
+	g.insert_edge('d', 'a', 3);
+
+	auto pool = gdwg::thread_pool(4);
+	auto const expected = std::vector<int>{0, 2, 1, 2, gdwg::unreachable<int>};
+	CHECK(gdwg::delta_stepping(g, 'a') == expected);
+	CHECK(gdwg::delta_stepping(g, 'a', 1, pool) == expected);
+	CHECK(gdwg::delta_stepping(g, 'a', 100, pool) == expected);
+
+	REQUIRE_THROWS_WITH(gdwg::delta_stepping(g, 'x'),
+	                    "Cannot call gdwg::delta_stepping if src doesn't exist in the graph");
+	g.insert_edge('e', 'a', -1);
+	REQUIRE_THROWS_WITH(gdwg::delta_stepping(g, 'a'),
+	                    "Cannot call gdwg::delta_stepping on a graph with negative edge weights");
+}
+
+TEST_CASE("delta-stepping: agrees with dijkstra for any delta and thread count") {
+	auto const g = gdwg_test::random_graph(300, 2000, 3, 0L, 100L);
+	auto const frozen = gdwg::frozen_graph<int, long>(g);
+
+	for (auto const threads : {1, 4}) {
+		auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+		for (auto const source : {0, 17, 299}) {
+			auto const expected = gdwg::dijkstra(frozen, source).distance;
+			for (auto const delta : {0L, 1L, 7L, 50L, 1000L}) {
+				CHECK(gdwg::delta_stepping(frozen, source, delta, pool) == expected);
+			}
+		}
+	}
+}
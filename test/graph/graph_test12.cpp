@@ -0,0 +1,158 @@
+#include "gdwg/traversal.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// A plain queue-based search to compare against.
+	template<typename N, typename E>
+	auto serial_depths(gdwg::frozen_graph<N, E> const& g, std::size_t source)
+	   -> std::vector<std::size_t> {
+		auto depth = std::vector<std::size_t>(g.size(), gdwg::unreachable<std::size_t>);
+		auto queue = std::deque<std::size_t>{source};
+		depth[source] = 0;
+		while (!queue.empty()) {
+			auto const from = queue.front();
+			queue.pop_front();
+			for (auto const to : g.out_neighbours(from)) {
+				if (depth[to] == gdwg::unreachable<std::size_t>) {
+					depth[to] = depth[from] + 1;
+					queue.push_back(to);
+				}
+			}
+		}
+		return depth;
+	}
+
+	template<typename N, typename E>
+	auto check_tree(gdwg::frozen_graph<N, E> const& g,
+	                std::size_t source,
+	                gdwg::bfs_tree const& tree) -> void {
+		CHECK(tree.depth == serial_depths(g, source));
+		CHECK(tree.parent[source] == gdwg::no_rank);
+		for (auto rank = std::size_t{0}; rank < g.size(); ++rank) {
+			if (rank == source || !tree.reached(rank)) {
+				CHECK(tree.parent[rank] == gdwg::no_rank);
+				continue;
+			}
+			auto const parent = tree.parent[rank];
+			REQUIRE(parent < g.size());
+			CHECK(tree.depth[parent] + 1 == tree.depth[rank]);
+			auto const sources = g.in_neighbours(rank);
+			CHECK(std::find(sources.begin(), sources.end(), parent) != sources.end());
+		}
+	}
+} // namespace
+
+TEST_CASE("bfs: depths and parents on a small graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "a", 1);
+	g.insert_edge("e", "a", 1);
+
+	auto const tree = gdwg::bfs(g, "a");
+	CHECK(tree.depth == std::vector<std::size_t>{0, 1, 1, 2, gdwg::unreachable<std::size_t>});
+	CHECK(tree.parent == std::vector<std::size_t>{gdwg::no_rank, 0, 0, 2, gdwg::no_rank});
+	CHECK(tree.reached(3));
+	CHECK(!tree.reached(4));
+
+	REQUIRE_THROWS_WITH(gdwg::bfs(g, "x"),
+	                    "Cannot call gdwg::bfs if src doesn't exist in the graph");
+}
+
+TEST_CASE("bfs: agrees with a serial search on random graphs") {
+	for (auto const edge_factor : {1, 4, 32}) {
+		auto const node_count = 500;
+		auto const g = gdwg_test::random_graph(node_count, edge_factor * node_count, 6771);
+		auto const frozen = gdwg::frozen_graph<int, void>(g);
+
+		for (auto const threads : {1, 4}) {
+			auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+			for (auto const source : {0, 250, 499}) {
+				check_tree(frozen, static_cast<std::size_t>(source), gdwg::bfs(frozen, source, pool));
+			}
+		}
+	}
+}
+
+TEST_CASE("bfs: a star goes bottom-up and a chain stays top-down") {
+	auto pool = gdwg::thread_pool(4);
+
+	// the hub's frontier holds every edge, so the second level runs bottom-up
+	auto star = gdwg::graph<int, void>{};
+	for (auto i = 0; i < 1000; ++i) {
+		star.insert_node(i);
+	}
+	for (auto i = 1; i < 1000; ++i) {
+		star.insert_edge(0, i);
+		star.insert_edge(i, (i % 999) + 1);
+	}
+	auto const frozen_star = gdwg::frozen_graph<int, void>(star);
+	check_tree(frozen_star, 0, gdwg::bfs(frozen_star, 0, pool));
+	check_tree(frozen_star, 5, gdwg::bfs(frozen_star, 5, pool));
+
+	auto chain = gdwg::graph<int, void>{};
+	for (auto i = 0; i < 200; ++i) {
+		chain.insert_node(i);
+	}
+	for (auto i = 0; i + 1 < 200; ++i) {
+		chain.insert_edge(i, i + 1);
+	}
+	auto const frozen_chain = gdwg::frozen_graph<int, void>(chain);
+	auto const tree = gdwg::bfs(frozen_chain, 0, pool);
+	check_tree(frozen_chain, 0, tree);
+	CHECK(tree.depth[199] == 199);
+}
+
+TEST_CASE("multi-source bfs: every batch agrees with single-source bfs") {
+	auto engine = std::mt19937(42);
+	auto const node_count = 400;
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	for (auto const edge_factor : {1, 8}) {
+		auto const g = gdwg_test::random_graph(node_count, edge_factor * node_count, 42, 1, 1);
+		auto const frozen = gdwg::frozen_graph<int, int>(g);
+
+		// 130 sources make two full batches and a partial one, with a repeated source
+		auto sources = std::vector<int>{};
+		for (auto i = 0; i < 129; ++i) {
+			sources.push_back(node(engine));
+		}
+		sources.push_back(sources.front());
+
+		for (auto const threads : {1, 4}) {
+			auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+			auto const depths =
+			   gdwg::multi_source_bfs(frozen, sources, gdwg::unreachable<std::size_t>, pool);
+			REQUIRE(depths.size() == sources.size());
+			for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+				CHECK(depths[i] == gdwg::bfs(frozen, sources[i], pool).depth);
+			}
+		}
+	}
+}
+
+TEST_CASE("multi-source bfs: max_depth limits the search to k hops") {
+	auto g = gdwg::graph<std::string, void>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b");
+	g.insert_edge("b", "c");
+	g.insert_edge("c", "d");
+	g.insert_edge("d", "a");
+
+	auto const none = gdwg::unreachable<std::size_t>;
+	auto const sources = std::vector<std::string>{"a", "c"};
+	auto const depths = gdwg::multi_source_bfs(g, sources, 2);
+	CHECK(depths[0] == std::vector<std::size_t>{0, 1, 2, none});
+	CHECK(depths[1] == std::vector<std::size_t>{2, none, 0, 1});
+	CHECK(gdwg::multi_source_bfs(g, std::vector<std::string>{}).empty());
+
+	REQUIRE_THROWS_WITH(gdwg::multi_source_bfs(g, std::vector<std::string>{"a", "x"}),
+	                    "Cannot call gdwg::multi_source_bfs if a source doesn't exist in the graph");
+}
@@ -0,0 +1,99 @@
+#include "gdwg/centrality.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+	// Dense power iteration straight from the definition, to compare against.
+	auto reference_pagerank(std::vector<std::vector<double>> const& weight, double damping)
+	   -> std::vector<double> {
+		auto const size = weight.size();
+		auto const n = static_cast<double>(size);
+		auto score = std::vector<double>(size, 1.0 / n);
+		for (auto iteration = 0; iteration < 500; ++iteration) {
+			auto next = std::vector<double>(size, (1.0 - damping) / n);
+			for (auto from = std::size_t{0}; from < size; ++from) {
+				auto const total = std::accumulate(weight[from].begin(), weight[from].end(), 0.0);
+				for (auto to = std::size_t{0}; to < size; ++to) {
+					next[to] += total == 0.0 ? damping * score[from] / n
+					                         : damping * score[from] * weight[from][to] / total;
+				}
+			}
+			score = next;
+		}
+		return score;
+	}
+
+	auto check_close(std::vector<double> const& actual, std::vector<double> const& expected)
+	   -> void {
+		REQUIRE(actual.size() == expected.size());
+		for (auto i = std::size_t{0}; i < actual.size(); ++i) {
+			CHECK(actual[i] == Approx(expected[i]).margin(1e-9));
+		}
+	}
+} // namespace
+
+TEST_CASE("pagerank: a cycle ranks every node equally") {
+	auto g = gdwg::graph<std::string, void>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b");
+	g.insert_edge("b", "c");
+	g.insert_edge("c", "d");
+	g.insert_edge("d", "a");
+
+	check_close(gdwg::pagerank(g), std::vector<double>(4, 0.25));
+	check_close(gdwg::pagerank(g, 0.5, 1e-12, gdwg::transition::by_weight),
+	            std::vector<double>(4, 0.25));
+	CHECK(gdwg::pagerank(gdwg::graph<int, int>{}).empty());
+}
+
+TEST_CASE("pagerank: uniform and weighted transitions with a dangling node") {
+	auto g = gdwg::graph<char, int>{'a', 'b', 'c', 'd'};
+	g.insert_edge('a', 'b', 3);
+	g.insert_edge('a', 'c', 1);
+	g.insert_edge('b', 'c', 2);
+	g.insert_edge('c', 'a', 1);
+	g.insert_edge('c', 'c', 1);
+
+	auto const uniform = std::vector<std::vector<double>>{{0, 1, 1, 0},
+	                                                      {0, 0, 1, 0},
+	                                                      {1, 0, 1, 0},
+	                                                      {0, 0, 0, 0}};
+	auto const weighted = std::vector<std::vector<double>>{{0, 3, 1, 0},
+	                                                       {0, 0, 2, 0},
+	                                                       {1, 0, 1, 0},
+	                                                       {0, 0, 0, 0}};
+	check_close(gdwg::pagerank(g, 0.85, 1e-12), reference_pagerank(uniform, 0.85));
+	check_close(gdwg::pagerank(g, 0.85, 1e-12, gdwg::transition::by_weight),
+	            reference_pagerank(weighted, 0.85));
+
+	auto const scores = gdwg::pagerank(g, 0.85, 1e-12, gdwg::transition::by_weight);
+	CHECK(std::accumulate(scores.begin(), scores.end(), 0.0) == Approx(1.0));
+
+	REQUIRE_THROWS_WITH(gdwg::pagerank(g, 1.0),
+	                    "Cannot call gdwg::pagerank with a damping factor outside [0, 1)");
+	g.insert_edge('d', 'a', -1);
+	REQUIRE_THROWS_WITH(gdwg::pagerank(g, 0.85, 1e-9, gdwg::transition::by_weight),
+	                    "Cannot call gdwg::pagerank on a graph with negative edge weights");
+	CHECK(gdwg::pagerank(g).size() == 4);
+}
+
+TEST_CASE("pagerank: agrees with dense power iteration for any thread count") {
+	auto const node_count = 80;
+	auto const g = gdwg_test::random_graph(node_count, 4 * node_count, 6771, 0, 9);
+	auto matrix = std::vector<std::vector<double>>(node_count, std::vector<double>(node_count));
+	for (auto const& [from, to, w] : g) {
+		matrix[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)] += w;
+	}
+	auto const expected = reference_pagerank(matrix, 0.85);
+	auto const frozen = gdwg::frozen_graph<int, int>(g);
+
+	for (auto const threads : {1, 4}) {
+		auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+		check_close(gdwg::pagerank(frozen, 0.85, 1e-13, gdwg::transition::by_weight, pool),
+		            expected);
+	}
+}
@@ -0,0 +1,145 @@
+#include "gdwg/components.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+	// Whether to is reachable from from, by a plain search over the graph's edges.
+	template<typename N, typename E>
+	auto reaches(gdwg::frozen_graph<N, E> const& g, std::size_t from, std::size_t to) -> bool {
+		auto seen = std::vector<bool>(g.size());
+		auto stack = std::vector<std::size_t>{from};
+		seen[from] = true;
+		while (!stack.empty()) {
+			auto const rank = stack.back();
+			stack.pop_back();
+			if (rank == to) {
+				return true;
+			}
+			for (auto const next : g.out_neighbours(rank)) {
+				if (!seen[next]) {
+					seen[next] = true;
+					stack.push_back(next);
+				}
+			}
+		}
+		return false;
+	}
+} // namespace
+
+TEST_CASE("strongly connected components: ids by rank in topological order") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "e", 1);
+	g.insert_edge("e", "c", 1);
+	g.insert_edge("f", "f", 1);
+
+	auto const component = gdwg::strongly_connected_components(g);
+	REQUIRE(component.size() == 6);
+	CHECK(component[0] == component[1]);
+	CHECK(component[2] == component[3]);
+	CHECK(component[3] == component[4]);
+	CHECK(component[0] < component[2]);
+	CHECK(std::set<std::size_t>(component.begin(), component.end())
+	      == std::set<std::size_t>{0, 1, 2});
+
+	CHECK(gdwg::strongly_connected_components(gdwg::graph<int, void>{}).empty());
+}
+
+TEST_CASE("strongly connected components: match mutual reachability on random graphs") {
+	auto const node_count = 60;
+	for (auto const edge_count : {30, 60, 90, 150}) {
+		auto const g = gdwg_test::random_graph(node_count, edge_count, 6771);
+		auto const frozen = gdwg::frozen_graph<int, void>(g);
+		auto const component = gdwg::strongly_connected_components(frozen);
+
+		for (auto from = std::size_t{0}; from < frozen.size(); ++from) {
+			for (auto const to : frozen.out_neighbours(from)) {
+				CHECK(component[from] <= component[to]);
+			}
+			for (auto to = from + 1; to < frozen.size(); ++to) {
+				auto const together = reaches(frozen, from, to) && reaches(frozen, to, from);
+				CHECK((component[from] == component[to]) == together);
+			}
+		}
+	}
+}
+
+TEST_CASE("strongly connected components: long chains do not recurse") {
+	auto const length = 300000;
+	auto g = gdwg::graph<int, void>{};
+	for (auto i = 0; i < length; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i + 1 < length; ++i) {
+		g.insert_edge(i, i + 1);
+	}
+
+	auto component = gdwg::strongly_connected_components(g);
+	auto expected = std::vector<std::size_t>(length);
+	std::iota(expected.begin(), expected.end(), std::size_t{0});
+	CHECK(component == expected);
+
+	// closing the chain into a cycle makes it a single component
+	g.insert_edge(length - 1, 0);
+	component = gdwg::strongly_connected_components(g);
+	CHECK(std::set<std::size_t>(component.begin(), component.end()) == std::set<std::size_t>{0});
+}
+
+TEST_CASE("weakly connected components: ignore direction and number by first node") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("c", "e", 1);
+	g.insert_edge("e", "d", 1);
+	g.insert_edge("f", "f", 1);
+
+	CHECK(gdwg::weakly_connected_components(g) == std::vector<std::size_t>{0, 0, 1, 1, 1, 2});
+	CHECK(gdwg::weakly_connected_components(gdwg::graph<int, void>{}).empty());
+}
+
+TEST_CASE("weakly connected components: agree with a serial search for any thread count") {
+	auto const node_count = 2000;
+	for (auto const edge_count : {500, 1000, 3000}) {
+		auto const g = gdwg_test::random_graph(node_count, edge_count, 42);
+		auto const frozen = gdwg::frozen_graph<int, void>(g);
+
+		// label by flooding along edges in both directions, numbering components as found
+		auto expected = std::vector<std::size_t>(node_count, gdwg::no_rank);
+		auto found = std::size_t{0};
+		for (auto root = std::size_t{0}; root < frozen.size(); ++root) {
+			if (expected[root] != gdwg::no_rank) {
+				continue;
+			}
+			auto stack = std::vector<std::size_t>{root};
+			expected[root] = found;
+			while (!stack.empty()) {
+				auto const rank = stack.back();
+				stack.pop_back();
+				auto const out = frozen.out_neighbours(rank);
+				auto const in = frozen.in_neighbours(rank);
+				for (auto const neighbours : {out, in}) {
+					for (auto const next : neighbours) {
+						if (expected[next] == gdwg::no_rank) {
+							expected[next] = found;
+							stack.push_back(next);
+						}
+					}
+				}
+			}
+			++found;
+		}
+
+		for (auto const threads : {1, 4}) {
+			auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+			CHECK(gdwg::weakly_connected_components(frozen, pool) == expected);
+		}
+	}
+}
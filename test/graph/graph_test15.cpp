@@ -0,0 +1,141 @@
+#include "gdwg/dag.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Whether every edge of the dag goes forwards in its order.
+	template<typename N, typename E>
+	auto is_topological(gdwg::dag<N, E> const& d) -> bool {
+		auto const order = d.order();
+		auto position = std::map<N, std::size_t>{};
+		for (auto i = std::size_t{0}; i < order.size(); ++i) {
+			position[order[i]] = i;
+		}
+		for (auto const& edge : d.as_graph()) {
+			if (position.at(edge.from) >= position.at(edge.to)) {
+				return false;
+			}
+		}
+		return order.size() == d.as_graph().nodes().size();
+	}
+
+	// Whether to is reachable from from.
+	auto reaches(gdwg::graph<int, void> const& g, int from, int to) -> bool {
+		auto seen = std::vector<int>{from};
+		for (auto i = std::size_t{0}; i < seen.size(); ++i) {
+			if (seen[i] == to) {
+				return true;
+			}
+			for (auto const next : g.connections(seen[i])) {
+				if (std::find(seen.begin(), seen.end(), next) == seen.end()) {
+					seen.push_back(next);
+				}
+			}
+		}
+		return false;
+	}
+} // namespace
+
+TEST_CASE("dag: edges reorder nodes and cycles are rejected") {
+	auto d = gdwg::dag<std::string, int>{"c", "b", "a"};
+	CHECK(d.order() == std::vector<std::string>{"c", "b", "a"});
+
+	CHECK(d.insert_edge("a", "b", 1));
+	CHECK(d.insert_edge("b", "c", 1));
+	CHECK(d.order() == std::vector<std::string>{"a", "b", "c"});
+	CHECK(d.precedes("a", "c"));
+	CHECK(!d.insert_edge("a", "b", 1));
+	CHECK(d.insert_edge("a", "b", 2));
+
+	REQUIRE_THROWS_WITH(d.insert_edge("c", "a", 1),
+	                    "Cannot call gdwg::dag<N, E>::insert_edge if the edge would create a cycle");
+	REQUIRE_THROWS_WITH(d.insert_edge("b", "b", 1),
+	                    "Cannot call gdwg::dag<N, E>::insert_edge if the edge would create a cycle");
+	CHECK(!d.as_graph().is_connected("c", "a"));
+	CHECK(d.order() == std::vector<std::string>{"a", "b", "c"});
+	REQUIRE_THROWS_WITH(d.insert_edge("a", "x", 1),
+	                    "Cannot call gdwg::dag<N, E>::insert_edge when either src or dst node does "
+	                    "not exist");
+	REQUIRE_THROWS_WITH(d.precedes("a", "x"),
+	                    "Cannot call gdwg::dag<N, E>::precedes if lhs or rhs node don't exist in "
+	                    "the graph");
+
+	// one of the parallel a -> b edges still orders a first
+	CHECK(d.erase_edge("a", "b", 1));
+	CHECK_THROWS_AS(d.insert_edge("b", "a", 1), std::runtime_error);
+	CHECK(d.erase_edge("a", "b", 2));
+	CHECK(d.insert_edge("b", "a", 1));
+	CHECK(is_topological(d));
+
+	auto copy = d;
+	CHECK(copy == d);
+	CHECK(copy.erase_node("b"));
+	CHECK(copy.order() == std::vector<std::string>{"a", "c"});
+	CHECK(copy.insert_edge("c", "a", 1));
+	CHECK(copy.order() == std::vector<std::string>{"c", "a"});
+	CHECK(d.order().size() == 3);
+}
+
+TEST_CASE("dag: clearing forgets every node an earlier reorder visited") {
+	auto d = gdwg::dag<int, int>{};
+	for (auto i = 0; i < 20; ++i) {
+		d.insert_node(i);
+	}
+	for (auto i = 1; i < 20; ++i) {
+		CHECK(d.insert_edge(i, i - 1, 1));
+	}
+	CHECK(is_topological(d));
+
+	d.clear();
+	CHECK(d.insert_node(7));
+	REQUIRE_THROWS_WITH(d.insert_edge(7, 7, 1),
+	                    "Cannot call gdwg::dag<N, E>::insert_edge if the edge would create a cycle");
+	CHECK(d.insert_node(3));
+	CHECK(d.insert_edge(7, 3, 1));
+	CHECK(d.order() == std::vector<int>{7, 3});
+}
+
+TEST_CASE("dag: random insertions keep a topological order") {
+	auto engine = std::mt19937(6771);
+	auto const node_count = 80;
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	auto d = gdwg::dag<int, void>{};
+	for (auto i = 0; i < node_count; ++i) {
+		d.insert_node(node_count - 1 - i);
+	}
+
+	// the edges of a random graph, tried in random order
+	auto edges = std::vector<std::pair<int, int>>{};
+	for (auto const& [from, to] : gdwg_test::random_graph(node_count, 600, 6771)) {
+		edges.emplace_back(from, to);
+	}
+	std::shuffle(edges.begin(), edges.end(), engine);
+	for (auto i = std::size_t{0}; i < edges.size(); ++i) {
+		auto const [from, to] = edges[i];
+		if (!d.is_node(from) || !d.is_node(to)) {
+			continue;
+		}
+		auto const cycle = from == to || reaches(d.as_graph(), to, from);
+		if (cycle) {
+			CHECK_THROWS_AS(d.insert_edge(from, to), std::runtime_error);
+		}
+		else {
+			auto const fresh = !d.as_graph().is_connected(from, to);
+			CHECK(d.insert_edge(from, to) == fresh);
+		}
+		REQUIRE(is_topological(d));
+		if (i % 50 == 49) {
+			d.erase_node(node(engine));
+			REQUIRE(is_topological(d));
+		}
+	}
+}
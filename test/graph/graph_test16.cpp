@@ -0,0 +1,178 @@
+#include "gdwg/reachability.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	// Whether to is reachable from from, by a fresh search.
+	auto reaches(gdwg::graph<int, int> const& g, int from, int to) -> bool {
+		auto seen = std::vector<int>{from};
+		for (auto i = std::size_t{0}; i < seen.size(); ++i) {
+			if (seen[i] == to) {
+				return true;
+			}
+			for (auto const next : g.connections(seen[i])) {
+				if (std::find(seen.begin(), seen.end(), next) == seen.end()) {
+					seen.push_back(next);
+				}
+			}
+		}
+		return false;
+	}
+
+	auto check_index(gdwg::graph<int, int> const& g, gdwg::reachability_index<int, int> const& index)
+	   -> void {
+		for (auto const from : g.nodes()) {
+			for (auto const to : g.nodes()) {
+				CHECK(index.reachable(from, to) == reaches(g, from, to));
+			}
+		}
+	}
+
+	// Counts the notifications a graph sends.
+	struct counting_observer : gdwg::graph_observer<std::string, int> {
+		int nodes = 0;
+		int edges = 0;
+		int changes = 0;
+		bool destroyed = false;
+
+		auto node_inserted(std::string const&) -> void override {
+			++nodes;
+		}
+		auto node_erased(std::string const&) -> void override {
+			--nodes;
+		}
+		auto edge_inserted(gdwg::graph<std::string, int>::value_type const&) -> void override {
+			++edges;
+		}
+		auto edge_erased(gdwg::graph<std::string, int>::value_type const&) -> void override {
+			--edges;
+		}
+		auto graph_changed() noexcept -> void override {
+			++changes;
+		}
+		auto graph_destroyed() noexcept -> void override {
+			destroyed = true;
+		}
+	};
+} // namespace
+
+TEST_CASE("graph observers: every successful change is reported") {
+	auto observer = counting_observer{};
+	{
+		auto g = gdwg::graph<std::string, int>{"a", "b"};
+		g.subscribe(observer);
+		CHECK(g.insert_node("c"));
+		CHECK(!g.insert_node("c"));
+		CHECK(g.insert_edge("a", "b", 1));
+		CHECK(!g.insert_edge("a", "b", 1));
+		CHECK(g.insert_edge("b", "c", 2));
+		CHECK(g.erase_edge("a", "b", 1));
+		CHECK(!g.erase_edge("a", "b", 1));
+		g.erase_edge(g.begin());
+		CHECK(observer.nodes == 1);
+		CHECK(observer.edges == 0);
+		CHECK(observer.changes == 0);
+
+		CHECK(g.erase_node(std::string_view("c")));
+		CHECK(observer.nodes == 0);
+		CHECK(g.replace_node("a", "z"));
+		g.clear();
+		CHECK(observer.changes == 2);
+
+		// copies do not inherit observers, but assigning over the graph is a change
+		auto copy = g;
+		copy.insert_node("x");
+		CHECK(observer.nodes == 0);
+		g = copy;
+		CHECK(observer.changes == 3);
+
+		g.unsubscribe(observer);
+		g.insert_node("y");
+		CHECK(observer.nodes == 0);
+		g.subscribe(observer);
+	}
+	CHECK(observer.destroyed);
+}
+
+TEST_CASE("reachability index: answers through cycles and across components") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6};
+	g.insert_edge(1, 2, 0);
+	g.insert_edge(2, 3, 0);
+	g.insert_edge(3, 1, 0);
+	g.insert_edge(3, 4, 0);
+	g.insert_edge(5, 4, 0);
+
+	auto const index = gdwg::reachability_index(g);
+	CHECK(index.reachable(1, 4));
+	CHECK(index.reachable(3, 2));
+	CHECK(index.reachable(6, 6));
+	CHECK(!index.reachable(4, 1));
+	CHECK(!index.reachable(1, 5));
+	CHECK(!index.reachable(1, 6));
+	check_index(g, index);
+	CHECK(index.reachable(1UL, 4L));
+	CHECK(!index.reachable(4.0, 1U));
+
+	REQUIRE_THROWS_WITH(index.reachable(0x1'0000'0001L, 4),
+	                    "Cannot call gdwg::reachability_index::reachable if src or dst node don't "
+	                    "exist in the graph");
+	REQUIRE_THROWS_WITH(index.reachable(1, 7),
+	                    "Cannot call gdwg::reachability_index::reachable if src or dst node don't "
+	                    "exist in the graph");
+}
+
+TEST_CASE("reachability index: keeps up with random changes to the graph") {
+	auto engine = std::mt19937(6771);
+	auto action = std::uniform_int_distribution<int>(0, 9);
+	auto node = std::uniform_int_distribution<int>(0, 39);
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < 30; ++i) {
+		g.insert_node(i);
+	}
+	auto const index = gdwg::reachability_index(g);
+
+	for (auto step = 0; step < 300; ++step) {
+		auto const from = node(engine);
+		auto const to = node(engine);
+		switch (action(engine)) {
+		case 0: g.insert_node(from); break;
+		case 1: g.erase_node(from); break;
+		case 2:
+			if (g.is_node(from) && g.is_node(to)) {
+				g.erase_edge(from, to, 0);
+			}
+			break;
+		default:
+			if (g.is_node(from) && g.is_node(to)) {
+				g.insert_edge(from, to, 0);
+			}
+			break;
+		}
+		if (step % 10 == 9) {
+			check_index(g, index);
+		}
+	}
+
+	g.clear();
+	g.insert_node(1);
+	CHECK(index.reachable(1, 1));
+}
+
+TEST_CASE("reachability index: outlives its graph") {
+	auto g = std::make_unique<gdwg::graph<int, int>>(std::initializer_list<int>{1, 2});
+	g->insert_edge(1, 2, 0);
+	auto const index = gdwg::reachability_index(*g);
+	g->insert_node(3);
+	g.reset();
+
+	CHECK(index.reachable(1, 2));
+	CHECK(!index.reachable(3, 1));
+}
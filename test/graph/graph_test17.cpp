@@ -0,0 +1,95 @@
+#include "gdwg/neighbourhood.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	// Adjacency of the simple undirected graph underneath g.
+	auto undirected(gdwg::frozen_graph<int, void> const& g) -> std::vector<std::vector<bool>> {
+		auto adjacent = std::vector<std::vector<bool>>(g.size(), std::vector<bool>(g.size()));
+		for (auto from = std::size_t{0}; from < g.size(); ++from) {
+			for (auto const to : g.out_neighbours(from)) {
+				if (from != to) {
+					adjacent[from][to] = true;
+					adjacent[to][from] = true;
+				}
+			}
+		}
+		return adjacent;
+	}
+} // namespace
+
+TEST_CASE("triangles: direction, parallel edges and self-loops are ignored") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("c", "b", 1);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "c", 1);
+	g.insert_edge("c", "d", 1);
+	CHECK(gdwg::count_triangles(g) == 1);
+
+	g.insert_edge("d", "a", 1);
+	CHECK(gdwg::count_triangles(g) == 2);
+	g.insert_edge("b", "d", 1);
+	CHECK(gdwg::count_triangles(g) == 4);
+	CHECK(gdwg::count_triangles(gdwg::graph<int, void>{}) == 0);
+}
+
+TEST_CASE("common neighbours: shared neighbours in either direction") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("d", "a", 1);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("b", "b", 1);
+	g.insert_edge("e", "e", 1);
+
+	CHECK(gdwg::common_neighbours(g, "a", "b") == std::vector<std::string>{"c", "d"});
+	CHECK(gdwg::common_neighbours(g, "c", "d") == std::vector<std::string>{"a", "b"});
+	CHECK(gdwg::common_neighbours(g, "a", "e").empty());
+	CHECK(gdwg::common_neighbours(gdwg::frozen_graph<std::string, int>(g), "a", "b")
+	      == std::vector<std::size_t>{2, 3});
+
+	REQUIRE_THROWS_WITH(gdwg::common_neighbours(g, "a", "x"),
+	                    "Cannot call gdwg::common_neighbours if a or b node don't exist in the "
+	                    "graph");
+}
+
+TEST_CASE("triangles and common neighbours: agree with brute force on random graphs") {
+	auto const node_count = 120;
+	for (auto const edge_count : {200, 800, 3000}) {
+		auto g = gdwg_test::random_graph(node_count, edge_count, 6771);
+		// a hub makes some neighbour lists far longer than others, exercising galloping
+		for (auto i = 1; i < node_count; i += 2) {
+			g.insert_edge(0, i);
+		}
+		auto const frozen = gdwg::frozen_graph<int, void>(g);
+		auto const adjacent = undirected(frozen);
+
+		auto triangles = std::size_t{0};
+		for (auto a = std::size_t{0}; a < frozen.size(); ++a) {
+			for (auto b = a + 1; b < frozen.size(); ++b) {
+				auto common = std::vector<std::size_t>{};
+				for (auto c = std::size_t{0}; c < frozen.size(); ++c) {
+					if (adjacent[a][c] && adjacent[b][c]) {
+						common.push_back(c);
+						triangles += static_cast<std::size_t>(adjacent[a][b] && c > b);
+					}
+				}
+				CHECK(gdwg::common_neighbours(frozen, static_cast<int>(a), static_cast<int>(b))
+				      == common);
+			}
+		}
+
+		for (auto const threads : {1, 4}) {
+			auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+			CHECK(gdwg::count_triangles(frozen, pool) == triangles);
+		}
+	}
+}
@@ -0,0 +1,102 @@
+#include "gdwg/spanning.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// The weight of a minimum spanning forest by Kruskal's algorithm.
+	auto kruskal_weight(gdwg::graph<int, int> const& g) -> long {
+		auto edges = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			edges.emplace_back(weight, from, to);
+		}
+		std::sort(edges.begin(), edges.end());
+
+		auto parent = std::vector<int>(g.nodes().size());
+		std::iota(parent.begin(), parent.end(), 0);
+		auto const find = [&parent](int node) {
+			while (parent[static_cast<std::size_t>(node)] != node) {
+				node = parent[static_cast<std::size_t>(node)];
+			}
+			return node;
+		};
+		auto total = long{0};
+		for (auto const& [weight, from, to] : edges) {
+			auto const lhs = find(from);
+			auto const rhs = find(to);
+			if (lhs != rhs) {
+				parent[static_cast<std::size_t>(lhs)] = rhs;
+				total += weight;
+			}
+		}
+		return total;
+	}
+} // namespace
+
+TEST_CASE("minimum spanning forest: lightest of parallel edges, ignoring self-loops") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 5);
+	g.insert_edge("b", "a", 2);
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("b", "c", 4);
+	g.insert_edge("c", "a", 6);
+	g.insert_edge("c", "c", -1);
+	g.insert_edge("e", "d", 7);
+
+	auto const forest = gdwg::minimum_spanning_forest(g);
+	auto chosen = std::vector<std::tuple<std::string, std::string, int>>{};
+	for (auto const& [from, to, weight] : forest) {
+		chosen.emplace_back(from, to, weight);
+	}
+	CHECK(chosen
+	      == std::vector<std::tuple<std::string, std::string, int>>{{"b", "a", 2},
+	                                                                 {"b", "c", 4},
+	                                                                 {"e", "d", 7}});
+
+	CHECK(gdwg::minimum_spanning_forest(gdwg::graph<int, int>{}).empty());
+	CHECK(gdwg::minimum_spanning_forest(gdwg::graph<int, int>{1, 2}).empty());
+}
+
+TEST_CASE("minimum spanning forest: unweighted graphs get any spanning forest") {
+	auto g = gdwg::graph<int, void>{1, 2, 3, 4, 5};
+	g.insert_edge(1, 2);
+	g.insert_edge(2, 3);
+	g.insert_edge(3, 1);
+	g.insert_edge(5, 4);
+	g.insert_edge(4, 5);
+	CHECK(gdwg::minimum_spanning_forest(g).size() == 3);
+}
+
+TEST_CASE("minimum spanning forest: matches Kruskal on random graphs") {
+	auto const node_count = 200;
+	for (auto const edge_count : {50, 300, 2000}) {
+		// few distinct weights, so ties are common
+		auto const g = gdwg_test::random_graph(node_count, edge_count, 6771, -5, 20);
+		auto const components = gdwg::weakly_connected_components(g);
+		auto const trees = *std::max_element(components.begin(), components.end()) + 1;
+
+		for (auto const threads : {1, 4}) {
+			auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+			auto const forest = gdwg::minimum_spanning_forest(g, pool);
+			CHECK(forest.size() == static_cast<std::size_t>(node_count) - trees);
+
+			auto total = long{0};
+			for (auto const& [from, to, w] : forest) {
+				CHECK(g.is_connected(from, to));
+				CHECK(components[static_cast<std::size_t>(from)]
+				      == components[static_cast<std::size_t>(to)]);
+				total += w;
+			}
+			CHECK(total == kruskal_weight(g));
+			CHECK(std::is_sorted(forest.begin(), forest.end(), [](auto const& lhs, auto const& rhs) {
+				return std::tie(lhs.from, lhs.to, lhs.weight) < std::tie(rhs.from, rhs.to, rhs.weight);
+			}));
+		}
+	}
+}
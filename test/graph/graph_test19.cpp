@@ -0,0 +1,89 @@
+#include "gdwg/shortest_paths.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST_CASE("all pairs shortest paths: lightest parallel edges and unreachable pairs") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 7);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("b", "c", 3);
+	g.insert_edge("a", "c", 6);
+	g.insert_edge("c", "c", 1);
+	g.insert_edge("c", "a", 0);
+
+	auto const d = gdwg::all_pairs_shortest_paths(g);
+	REQUIRE(d.size == 4);
+	CHECK(d(0, 1) == 2);
+	CHECK(d(0, 2) == 5);
+	CHECK(d(2, 1) == 2);
+	CHECK(d(2, 2) == 0);
+	CHECK(!d.reached(0, 3));
+	CHECK(d(3, 0) == gdwg::unreachable<int>);
+	CHECK(d(3, 3) == 0);
+
+	CHECK(gdwg::all_pairs_shortest_paths(gdwg::graph<int, int>{}).distance.empty());
+
+	g.insert_edge("d", "a", -1);
+	REQUIRE_THROWS_WITH(gdwg::all_pairs_shortest_paths(g),
+	                    "Cannot call gdwg::all_pairs_shortest_paths on a graph with negative edge "
+	                    "weights");
+}
+
+TEST_CASE("all pairs shortest paths: floating point weights use infinity for unreachable pairs") {
+	auto g = gdwg::graph<int, double>{1, 2, 3};
+	g.insert_edge(1, 2, 0.5);
+	g.insert_edge(2, 1, 0.25);
+
+	auto const d = gdwg::all_pairs_shortest_paths(g);
+	CHECK(d(1, 0) == 0.25);
+	CHECK(d(0, 2) == std::numeric_limits<double>::infinity());
+}
+
+TEMPLATE_TEST_CASE("all pairs shortest paths: distances too long for E are unreachable",
+                   "",
+                   int,
+                   unsigned,
+                   std::int64_t) {
+	constexpr auto most = std::numeric_limits<TestType>::max();
+	auto g = gdwg::graph<int, TestType>{0, 1, 2, 3};
+	g.insert_edge(0, 1, most - 10);
+	g.insert_edge(1, 2, 20);
+	g.insert_edge(1, 3, 5);
+	g.insert_edge(3, 2, most / 2);
+	g.insert_edge(2, 3, 3);
+
+	auto const d = gdwg::all_pairs_shortest_paths(g);
+	CHECK(d(0, 3) == most - 5);
+	CHECK(!d.reached(0, 2));
+	CHECK(d(1, 2) == 20);
+	CHECK(d(1, 3) == 5);
+	CHECK(d(2, 3) == 3);
+	CHECK(d(3, 2) == most / 2);
+}
+
+TEST_CASE("all pairs shortest paths: agrees with dijkstra across tile boundaries") {
+	// sizes either side of whole tiles, so edge tiles are partial
+	for (auto const node_count : {1, 63, 64, 65, 150}) {
+		auto const g = gdwg_test::random_graph(node_count, 3 * node_count, 6771, 0u, 50u);
+		auto const frozen = gdwg::frozen_graph<int, unsigned>(g);
+
+		for (auto const threads : {1, 4}) {
+			auto pool = gdwg::thread_pool(static_cast<std::size_t>(threads));
+			auto const d = gdwg::all_pairs_shortest_paths(frozen, pool);
+			for (auto from = 0; from < node_count; ++from) {
+				auto const expected = gdwg::dijkstra(frozen, from).distance;
+				auto const row = std::vector<unsigned>(
+				   d.distance.begin() + from * node_count,
+				   d.distance.begin() + (from + 1) * node_count);
+				CHECK(row == expected);
+			}
+		}
+	}
+}
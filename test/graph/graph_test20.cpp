@@ -0,0 +1,113 @@
+#include "gdwg/contraction.hpp"
+#include "gdwg/shortest_paths.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("contraction hierarchy: small graph with parallel edges and unreachable nodes") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 2);
+	g.insert_edge("a", "c", 5);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "a", 7);
+	g.insert_edge("d", "d", 0);
+
+	auto const ch = gdwg::contraction_hierarchy(g);
+	CHECK(ch.size() == 5);
+	CHECK(ch.distance("a", "d") == 4);
+	CHECK(ch.distance("d", "c") == 10);
+	CHECK(ch.distance("b", "b") == 0);
+	CHECK(ch.distance("a", "e") == gdwg::unreachable<int>);
+	CHECK(ch.distance("e", "e") == 0);
+
+	// copies answer alike, each with scratch space of its own
+	auto copy = ch;
+	CHECK(copy.distance("a", "d") == 4);
+	copy = gdwg::contraction_hierarchy(gdwg::graph<std::string, int>{"a"});
+	CHECK(copy.distance("a", "a") == 0);
+	CHECK(ch.distance("d", "c") == 10);
+
+	REQUIRE_THROWS_WITH(ch.distance("a", "x"),
+	                    "Cannot call gdwg::contraction_hierarchy::distance if src or dst node don't "
+	                    "exist in the graph");
+	g.insert_edge("e", "a", -1);
+	REQUIRE_THROWS_WITH(gdwg::contraction_hierarchy(g),
+	                    "Cannot call gdwg::contraction_hierarchy on a graph with negative edge "
+	                    "weights");
+}
+
+TEST_CASE("contraction hierarchy: floating point weights use infinity for unreachable nodes") {
+	auto g = gdwg::graph<int, double>{1, 2, 3};
+	g.insert_edge(1, 2, 0.5);
+	g.insert_edge(2, 1, 0.25);
+
+	auto const ch = gdwg::contraction_hierarchy(gdwg::frozen_graph<int, double>(g));
+	CHECK(ch.distance(2, 1) == 0.25);
+	CHECK(ch.distance(1, 3) == std::numeric_limits<double>::infinity());
+
+	// keys of other arithmetic types compare by value, and never wrap onto a node
+	CHECK(ch.distance(2UL, 1L) == 0.25);
+	CHECK(ch.distance(1.0, 2U) == 0.5);
+	REQUIRE_THROWS_WITH(ch.distance(0x1'0000'0002L, 1),
+	                    "Cannot call gdwg::contraction_hierarchy::distance if src or dst node don't "
+	                    "exist in the graph");
+}
+
+TEST_CASE("contraction hierarchy: agrees with dijkstra on road-like and random graphs") {
+	auto engine = std::mt19937(6771);
+	auto weight = std::uniform_int_distribution<unsigned>(0, 50);
+
+	// a grid with both directions of most streets, and some one-way ones
+	auto const side = 15;
+	auto grid = gdwg::graph<int, unsigned>{};
+	for (auto i = 0; i < side * side; ++i) {
+		grid.insert_node(i);
+	}
+	auto const street = [&](int from, int to) {
+		grid.insert_edge(from, to, weight(engine));
+		if (weight(engine) > 5) {
+			grid.insert_edge(to, from, weight(engine));
+		}
+	};
+	for (auto i = 0; i < side * side; ++i) {
+		if (i % side + 1 < side) {
+			street(i, i + 1);
+		}
+		if (i + side < side * side) {
+			street(i, i + side);
+		}
+	}
+
+	auto random = gdwg_test::random_graph(150, 450, 6771, 0u, 50u);
+
+	for (auto const* const g : {&grid, &random}) {
+		auto const frozen = gdwg::frozen_graph<int, unsigned>(*g);
+		auto const ch = gdwg::contraction_hierarchy(frozen);
+		auto const size = static_cast<int>(frozen.size());
+		for (auto from = 0; from < size; from += 7) {
+			auto const expected = gdwg::dijkstra(frozen, from).distance;
+			for (auto to = 0; to < size; ++to) {
+				CHECK(ch.distance(from, to) == expected[static_cast<std::size_t>(to)]);
+			}
+		}
+
+		// queries share the hierarchy across threads
+		auto pool = gdwg::thread_pool(4);
+		auto mismatches = std::vector<int>(pool.size());
+		pool.for_each_index(frozen.size(), [&](std::size_t from, std::size_t thread) {
+			auto const expected = gdwg::dijkstra(frozen, from).distance;
+			for (auto to = std::size_t{0}; to < frozen.size(); to += 5) {
+				mismatches[thread] += static_cast<int>(ch.distance(from, to) != expected[to]);
+			}
+		});
+		CHECK(mismatches == std::vector<int>(pool.size()));
+	}
+}
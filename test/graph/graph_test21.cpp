@@ -0,0 +1,133 @@
+#include "gdwg/astar.hpp"
+#include "gdwg/shortest_paths.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST_CASE("astar: user heuristics guide the search to a shortest path") {
+	// a 10 x 10 grid of unit streets, plus a slow diagonal shortcut
+	auto const side = 10;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < side * side; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < side * side; ++i) {
+		if (i % side + 1 < side) {
+			g.insert_edge(i, i + 1, 1);
+			g.insert_edge(i + 1, i, 1);
+		}
+		if (i + side < side * side) {
+			g.insert_edge(i, i + side, 1);
+			g.insert_edge(i + side, i, 1);
+		}
+	}
+	g.insert_edge(0, 99, 30);
+
+	auto const manhattan = [side](int node) {
+		return std::abs(node % side - 9) + std::abs(node / side - 9);
+	};
+	auto const paths = gdwg::astar(g, 0, 99, manhattan);
+	CHECK(paths.distance[99] == 18);
+	CHECK(paths.path_to(99).size() == 19);
+
+	// nodes far off the way along the top row are never reached
+	auto const along_top = gdwg::astar(g, 0, 9, [side](int node) {
+		return std::abs(node % side - 9) + node / side;
+	});
+	CHECK(along_top.distance[9] == 9);
+	CHECK(!along_top.reached(90));
+
+	// admissible but inconsistent heuristics may settle nodes twice, yet stay exact
+	auto const erratic = [&](int node) { return node % 3 == 0 ? manhattan(node) : 0; };
+	CHECK(gdwg::astar<gdwg::pairing_heap>(g, 0, 99, erratic).distance[99] == 18);
+	CHECK(gdwg::astar(g, 5, 5, manhattan).distance[5] == 0);
+
+	REQUIRE_THROWS_WITH(gdwg::astar(g, 0, 100, manhattan),
+	                    "Cannot call gdwg::astar if src or dst node don't exist in the graph");
+	g.insert_edge(98, 97, -1);
+	REQUIRE_THROWS_WITH(gdwg::landmarks(g, 4),
+	                    "Cannot call gdwg::landmarks on a graph with negative edge weights");
+	REQUIRE_THROWS_WITH(gdwg::astar(g, 98, 99, [](int) { return 0; }),
+	                    "Cannot call gdwg::astar on a graph with negative edge weights");
+}
+
+TEST_CASE("astar: distances too long for E are unreachable") {
+	constexpr auto most = std::numeric_limits<int>::max();
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3};
+	g.insert_edge(0, 1, most - 10);
+	g.insert_edge(1, 2, 20);
+	g.insert_edge(1, 3, 5);
+	g.insert_edge(2, 3, 1);
+
+	auto const to_two = gdwg::astar(g, 0, 2, [](int node) { return node == 1 ? 20 : 0; });
+	CHECK(!to_two.reached(2));
+	CHECK(to_two.distance[2] == gdwg::unreachable<int>);
+	auto const to_three = gdwg::astar(g, 0, 3, [](int node) { return node == 1 ? 5 : 0; });
+	CHECK(to_three.distance[3] == most - 5);
+	CHECK(to_three.path_to(3) == std::vector<std::size_t>{0, 1, 3});
+
+	auto const bounds = gdwg::landmarks(g, 4);
+	CHECK(gdwg::astar(g, 0, 3, bounds).distance[3] == most - 5);
+	CHECK(!gdwg::astar(g, 0, 2, bounds).reached(2));
+}
+
+TEST_CASE("landmarks: bounds never exceed the true distance") {
+	auto g = gdwg::graph<std::string, double>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1.5);
+	g.insert_edge("b", "c", 2);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("c", "d", 4);
+
+	auto const frozen = gdwg::frozen_graph<std::string, double>(g);
+	auto const bounds = gdwg::landmarks(frozen, 3);
+	REQUIRE(bounds.ranks().size() == 3);
+	// the unreachable node is picked first
+	CHECK(bounds.ranks().front() == 4);
+	for (auto from = std::size_t{0}; from < frozen.size(); ++from) {
+		auto const exact = gdwg::dijkstra(frozen, frozen.node(from)).distance;
+		for (auto to = std::size_t{0}; to < frozen.size(); ++to) {
+			CHECK(bounds.lower_bound(from, to) <= exact[to]);
+		}
+	}
+	CHECK(bounds.lower_bound(0, 3) == 7.5);
+
+	CHECK(gdwg::landmarks(frozen, 10).ranks().size() == 5);
+	CHECK(gdwg::landmarks(gdwg::graph<int, int>{}, 4).ranks().empty());
+	REQUIRE_THROWS_WITH(gdwg::astar(gdwg::graph<std::string, double>{"a"}, "a", "a", bounds),
+	                    "Cannot call gdwg::astar with landmarks built for a different graph");
+}
+
+TEST_CASE("landmarks: astar agrees with dijkstra, also after weights rise") {
+	auto const node_count = 200;
+	auto const g = gdwg_test::random_graph(node_count, 4 * node_count, 6771, 1, 50);
+
+	auto pool = gdwg::thread_pool(4);
+	auto const bounds = gdwg::landmarks(g, 8, pool);
+	auto const check = [&](gdwg::graph<int, int> const& current) {
+		auto const frozen = gdwg::frozen_graph<int, int>(current);
+		for (auto from = 0; from < node_count; from += 9) {
+			auto const expected = gdwg::dijkstra(frozen, from).distance;
+			for (auto to = 0; to < node_count; to += 3) {
+				CHECK(gdwg::astar(frozen, from, to, bounds).distance[static_cast<std::size_t>(to)]
+				      == expected[static_cast<std::size_t>(to)]);
+			}
+		}
+	};
+	check(g);
+
+	// heavier traffic on a third of the edges keeps the old bounds valid
+	auto heavier = gdwg::graph<int, int>{};
+	for (auto i = 0; i < node_count; ++i) {
+		heavier.insert_node(i);
+	}
+	for (auto const& [from, to, w] : g) {
+		heavier.insert_edge(from, to, from % 3 == 0 ? w * 4 : w);
+	}
+	check(heavier);
+}
@@ -0,0 +1,127 @@
+#include "gdwg/k_shortest_paths.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+	// The lengths of every loopless path from from to to, by depth-first search.
+	auto all_path_lengths(gdwg::frozen_graph<int, int> const& g,
+	                      std::size_t from,
+	                      std::size_t to,
+	                      std::vector<char>& on_path,
+	                      int length,
+	                      std::vector<int>& lengths) -> void {
+		if (from == to) {
+			lengths.push_back(length);
+			return;
+		}
+		on_path[from] = 1;
+		auto const neighbours = g.out_neighbours(from);
+		for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+			auto const next = neighbours[i];
+			// parallel edges make the same path; only the lightest, which comes first, counts
+			if (!on_path[next] && (i == 0 || neighbours[i - 1] != next)) {
+				auto const weights = g.out_weights(from);
+				auto lightest = weights[i];
+				for (auto j = i; j < neighbours.size() && neighbours[j] == next; ++j) {
+					lightest = std::min(lightest, weights[j]);
+				}
+				all_path_lengths(g, next, to, on_path, length + lightest, lengths);
+			}
+		}
+		on_path[from] = 0;
+	}
+} // namespace
+
+TEST_CASE("k shortest paths: loopless paths in order of length") {
+	auto g = gdwg::graph<std::string, int>{"c", "d", "e", "f", "g", "h"};
+	g.insert_edge("c", "d", 3);
+	g.insert_edge("c", "e", 2);
+	g.insert_edge("d", "f", 4);
+	g.insert_edge("e", "d", 1);
+	g.insert_edge("e", "f", 2);
+	g.insert_edge("e", "g", 3);
+	g.insert_edge("f", "g", 2);
+	g.insert_edge("f", "h", 1);
+	g.insert_edge("g", "h", 2);
+	g.insert_edge("g", "h", 9);
+	g.insert_edge("h", "c", 1);
+
+	auto const paths = gdwg::k_shortest_paths(g, "c", "h", 3);
+	REQUIRE(paths.size() == 3);
+	CHECK(paths[0].length == 5);
+	CHECK(paths[0].nodes == std::vector<std::size_t>{0, 2, 3, 5});
+	CHECK(paths[1].length == 7);
+	CHECK(paths[1].nodes == std::vector<std::size_t>{0, 2, 4, 5});
+	CHECK(paths[2].length == 8);
+	CHECK(paths[2].nodes == std::vector<std::size_t>{0, 1, 3, 5});
+
+	CHECK(gdwg::k_shortest_paths(g, "c", "h", 100).size() == 7);
+	CHECK(gdwg::k_shortest_paths(g, "c", "h", 0).empty());
+	auto const itself = gdwg::k_shortest_paths(g, "d", "d", 4);
+	REQUIRE(itself.size() == 1);
+	CHECK(itself[0].nodes == std::vector<std::size_t>{1});
+
+	g.insert_node("z");
+	CHECK(gdwg::k_shortest_paths(g, "c", "z", 3).empty());
+	REQUIRE_THROWS_WITH(gdwg::k_shortest_paths(g, "c", "y", 3),
+	                    "Cannot call gdwg::k_shortest_paths if src or dst node don't exist in the "
+	                    "graph");
+	g.insert_edge("z", "c", -1);
+	REQUIRE_THROWS_WITH(gdwg::k_shortest_paths(g, "c", "h", 3),
+	                    "Cannot call gdwg::k_shortest_paths on a graph with negative edge weights");
+}
+
+TEST_CASE("k shortest paths: paths too long for E are left out") {
+	constexpr auto most = std::numeric_limits<int>::max();
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3};
+	g.insert_edge(0, 1, most - 10);
+	g.insert_edge(1, 3, 5);
+	g.insert_edge(1, 2, 20);
+	g.insert_edge(0, 2, 1);
+	g.insert_edge(2, 3, most - 3);
+
+	auto const paths = gdwg::k_shortest_paths(g, 0, 3, 3);
+	REQUIRE(paths.size() == 2);
+	CHECK(paths[0].length == most - 5);
+	CHECK(paths[0].nodes == std::vector<std::size_t>{0, 1, 3});
+	CHECK(paths[1].length == most - 2);
+	CHECK(paths[1].nodes == std::vector<std::size_t>{0, 2, 3});
+}
+
+TEST_CASE("k shortest paths: agree with exhaustive search on random graphs") {
+	auto engine = std::mt19937(6771);
+	auto const node_count = 9;
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	for (auto round = 0u; round < 20; ++round) {
+		auto const g = gdwg_test::random_graph(node_count, 3 * node_count, round, 0, 9);
+		auto const frozen = gdwg::frozen_graph<int, int>(g);
+		auto const to = static_cast<std::size_t>(node(engine));
+
+		auto on_path = std::vector<char>(frozen.size());
+		auto expected = std::vector<int>{};
+		all_path_lengths(frozen, 0, to, on_path, 0, expected);
+		std::sort(expected.begin(), expected.end());
+		expected.resize(std::min(expected.size(), std::size_t{15}));
+
+		auto const paths = gdwg::k_shortest_paths(frozen, 0, static_cast<int>(to), 15);
+		auto lengths = std::vector<int>{};
+		auto distinct = std::set<std::vector<std::size_t>>{};
+		for (auto const& [length, nodes] : paths) {
+			lengths.push_back(length);
+			distinct.insert(nodes);
+			CHECK(std::set<std::size_t>(nodes.begin(), nodes.end()).size() == nodes.size());
+			CHECK(nodes.front() == 0);
+			CHECK(nodes.back() == to);
+		}
+		CHECK(lengths == expected);
+		CHECK(distinct.size() == paths.size());
+	}
+}
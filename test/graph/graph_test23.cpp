@@ -0,0 +1,144 @@
+#include "gdwg/flow.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// The value of a maximum flow by Edmonds-Karp on a capacity matrix.
+	auto edmonds_karp(std::vector<std::vector<long>> capacity, std::size_t source, std::size_t sink)
+	   -> long {
+		auto const size = capacity.size();
+		auto total = long{0};
+		for (;;) {
+			auto parent = std::vector<std::size_t>(size, size);
+			parent[source] = source;
+			auto queue = std::vector<std::size_t>{source};
+			for (auto i = std::size_t{0}; i < queue.size() && parent[sink] == size; ++i) {
+				for (auto to = std::size_t{0}; to < size; ++to) {
+					if (parent[to] == size && capacity[queue[i]][to] > 0) {
+						parent[to] = queue[i];
+						queue.push_back(to);
+					}
+				}
+			}
+			if (parent[sink] == size) {
+				return total;
+			}
+			auto bottleneck = capacity[parent[sink]][sink];
+			for (auto to = sink; to != source; to = parent[to]) {
+				bottleneck = std::min(bottleneck, capacity[parent[to]][to]);
+			}
+			for (auto to = sink; to != source; to = parent[to]) {
+				capacity[parent[to]][to] -= bottleneck;
+				capacity[to][parent[to]] += bottleneck;
+			}
+			total += bottleneck;
+		}
+	}
+
+	// Checks capacities and conservation, returning the net flow out of source.
+	template<typename E>
+	auto check_flow(gdwg::graph<int, E> const& g, std::vector<E> const& flow, int source, int sink)
+	   -> E {
+		REQUIRE(flow.size() == static_cast<std::size_t>(std::distance(g.begin(), g.end())));
+		auto net = std::vector<E>(g.nodes().size());
+		auto edge = std::size_t{0};
+		for (auto const& [from, to, capacity] : g) {
+			CHECK(flow[edge] >= E{});
+			CHECK(flow[edge] <= capacity);
+			net[static_cast<std::size_t>(from)] += flow[edge];
+			net[static_cast<std::size_t>(to)] -= flow[edge];
+			++edge;
+		}
+		for (auto node = std::size_t{0}; node < net.size(); ++node) {
+			if (node != static_cast<std::size_t>(source) && node != static_cast<std::size_t>(sink)) {
+				CHECK(net[node] == Approx(0).margin(1e-9));
+			}
+		}
+		return net[static_cast<std::size_t>(source)];
+	}
+} // namespace
+
+TEST_CASE("max flow: textbook network") {
+	auto g = gdwg::graph<std::string, int>{"s", "v1", "v2", "v3", "v4", "t"};
+	g.insert_edge("s", "v1", 16);
+	g.insert_edge("s", "v2", 13);
+	g.insert_edge("v1", "v3", 12);
+	g.insert_edge("v2", "v1", 4);
+	g.insert_edge("v2", "v4", 14);
+	g.insert_edge("v3", "v2", 9);
+	g.insert_edge("v3", "t", 20);
+	g.insert_edge("v4", "v3", 7);
+	g.insert_edge("v4", "t", 4);
+
+	auto const result = gdwg::max_flow(g, "s", "t");
+	CHECK(result.value == 23);
+	REQUIRE(result.flow.size() == 9);
+
+	REQUIRE_THROWS_WITH(gdwg::max_flow(g, "s", "x"),
+	                    "Cannot call gdwg::max_flow if src or dst node don't exist in the graph");
+	REQUIRE_THROWS_WITH(gdwg::max_flow(g, "s", "s"),
+	                    "Cannot call gdwg::max_flow if src and dst are the same node");
+	g.insert_edge("t", "s", -1);
+	REQUIRE_THROWS_WITH(gdwg::max_flow(g, "s", "t"),
+	                    "Cannot call gdwg::max_flow on a graph with negative edge weights");
+}
+
+TEST_CASE("max flow: parallel edges are filled in order and self-loops carry nothing") {
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3};
+	g.insert_edge(0, 1, 3);
+	g.insert_edge(0, 1, 5);
+	g.insert_edge(1, 0, 2);
+	g.insert_edge(1, 1, 9);
+	g.insert_edge(1, 2, 6);
+	g.insert_edge(2, 1, 4);
+	g.insert_edge(3, 0, 9);
+
+	auto const result = gdwg::max_flow(g, 0, 2);
+	CHECK(result.value == 6);
+	// edges in order: 0->1 (3), 0->1 (5), 1->0, 1->1, 1->2, 2->1, 3->0
+	CHECK(result.flow == std::vector<int>{3, 3, 0, 0, 6, 0, 0});
+	CHECK(gdwg::max_flow(g, 2, 3).value == 0);
+}
+
+TEST_CASE("max flow: agrees with Edmonds-Karp on random graphs") {
+	auto engine = std::mt19937(6771);
+	for (auto const node_count : {6, 30, 120}) {
+		auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+		for (auto round = 0u; round < 10; ++round) {
+			auto const g = gdwg_test::random_graph(node_count, 4 * node_count, round, 0, 20);
+			auto const nodes = g.nodes();
+			auto real = gdwg::graph<int, double>(nodes.begin(), nodes.end());
+			auto matrix = std::vector<std::vector<long>>(
+			   static_cast<std::size_t>(node_count),
+			   std::vector<long>(static_cast<std::size_t>(node_count)));
+			for (auto const& [from, to, c] : g) {
+				if (from != to) {
+					matrix[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)] += c;
+				}
+				real.insert_edge(from, to, c / 4.0);
+			}
+			auto const source = node(engine);
+			auto sink = node(engine);
+			if (sink == source) {
+				sink = (source + 1) % node_count;
+			}
+
+			auto const expected = edmonds_karp(matrix,
+			                                   static_cast<std::size_t>(source),
+			                                   static_cast<std::size_t>(sink));
+			auto const result = gdwg::max_flow(g, source, sink);
+			CHECK(result.value == expected);
+			CHECK(check_flow(g, result.flow, source, sink) == result.value);
+
+			auto const fractional = gdwg::max_flow(real, source, sink);
+			CHECK(fractional.value == Approx(static_cast<double>(expected) / 4));
+			CHECK(check_flow(real, fractional.flow, source, sink) == Approx(fractional.value));
+		}
+	}
+}
@@ -0,0 +1,181 @@
+#include "gdwg/centrality.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	// Betweenness straight from the definition, from all-pairs distances and path counts.
+	template<typename E>
+	auto reference_betweenness(gdwg::frozen_graph<int, E> const& g) -> std::vector<double> {
+		auto const size = g.size();
+		auto const far = std::numeric_limits<long>::max() / 4;
+		auto distance = std::vector<std::vector<long>>(size, std::vector<long>(size, far));
+		auto const weight = [&](std::size_t edge) {
+			if constexpr (std::is_void_v<E>) {
+				static_cast<void>(edge);
+				return long{1};
+			}
+			else {
+				return static_cast<long>(g.weight(edge));
+			}
+		};
+		for (auto from = std::size_t{0}; from < size; ++from) {
+			distance[from][from] = 0;
+			auto const neighbours = g.out_neighbours(from);
+			for (auto i = std::size_t{0}; i < neighbours.size(); ++i) {
+				auto& d = distance[from][neighbours[i]];
+				d = std::min(d, weight(g.first_out_edge(from) + i));
+			}
+		}
+		for (auto via = std::size_t{0}; via < size; ++via) {
+			for (auto from = std::size_t{0}; from < size; ++from) {
+				for (auto to = std::size_t{0}; to < size; ++to) {
+					distance[from][to] =
+					   std::min(distance[from][to], distance[from][via] + distance[via][to]);
+				}
+			}
+		}
+
+		// paths[s][t] counts shortest paths, adding up over t's in-edges in order of distance
+		auto paths = std::vector<std::vector<double>>(size, std::vector<double>(size));
+		for (auto source = std::size_t{0}; source < size; ++source) {
+			auto order = std::vector<std::size_t>(size);
+			std::iota(order.begin(), order.end(), std::size_t{0});
+			std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+				return distance[source][a] < distance[source][b];
+			});
+			paths[source][source] = 1;
+			for (auto const to : order) {
+				auto const sources = g.in_neighbours(to);
+				for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+					auto const from = sources[i];
+					if (from != to && distance[source][from] < far
+					    && distance[source][from] + weight(g.in_edges(to)[i]) == distance[source][to])
+					{
+						paths[source][to] += paths[source][from];
+					}
+				}
+			}
+		}
+
+		auto result = std::vector<double>(size);
+		for (auto s = std::size_t{0}; s < size; ++s) {
+			for (auto t = std::size_t{0}; t < size; ++t) {
+				if (s == t || distance[s][t] >= far) {
+					continue;
+				}
+				for (auto v = std::size_t{0}; v < size; ++v) {
+					if (v != s && v != t && distance[s][v] + distance[v][t] == distance[s][t]) {
+						result[v] += paths[s][v] * paths[v][t] / paths[s][t];
+					}
+				}
+			}
+		}
+		return result;
+	}
+
+	auto check_close(std::vector<double> const& actual, std::vector<double> const& expected)
+	   -> void {
+		REQUIRE(actual.size() == expected.size());
+		for (auto i = std::size_t{0}; i < actual.size(); ++i) {
+			CHECK(actual[i] == Approx(expected[i]).margin(1e-9));
+		}
+	}
+} // namespace
+
+TEST_CASE("betweenness: paths, stars and diamonds") {
+	auto path = gdwg::graph<std::string, void>{"a", "b", "c", "d"};
+	path.insert_edge("a", "b");
+	path.insert_edge("b", "c");
+	path.insert_edge("c", "d");
+	check_close(gdwg::betweenness_centrality(path), {0, 2, 2, 0});
+
+	auto star = gdwg::graph<int, int>{0, 1, 2, 3, 4};
+	for (auto leaf = 1; leaf <= 4; ++leaf) {
+		star.insert_edge(0, leaf, 3);
+		star.insert_edge(leaf, 0, 3);
+	}
+	check_close(gdwg::betweenness_centrality(star), {12, 0, 0, 0, 0});
+	check_close(gdwg::betweenness_centrality(star, {.normalised = true}), {1, 0, 0, 0, 0});
+
+	// the heavier edge a -> b and the self-loop b -> b are never on a shortest path
+	auto diamond = gdwg::graph<char, double>{'a', 'b', 'c', 'd'};
+	diamond.insert_edge('a', 'b', 1);
+	diamond.insert_edge('a', 'b', 1.5);
+	diamond.insert_edge('b', 'b', 0);
+	diamond.insert_edge('a', 'c', 0.5);
+	diamond.insert_edge('b', 'd', 1);
+	diamond.insert_edge('c', 'd', 1.5);
+	check_close(gdwg::betweenness_centrality(diamond), {0, 0.5, 0.5, 0});
+
+	CHECK(gdwg::betweenness_centrality(gdwg::graph<int, int>{}).empty());
+	diamond.insert_edge('d', 'a', -1);
+	REQUIRE_THROWS_WITH(gdwg::betweenness_centrality(diamond),
+	                    "Cannot call gdwg::betweenness_centrality on a graph with negative edge "
+	                    "weights");
+}
+
+TEST_CASE("betweenness: paths too long for E do not count") {
+	constexpr auto most = std::numeric_limits<int>::max();
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3};
+	g.insert_edge(0, 1, most - 10);
+	g.insert_edge(1, 2, 20);
+	g.insert_edge(1, 3, 5);
+	// only 0 -> 1 -> 3 passes through another node; 0 -> 1 -> 2 is unreachable in int
+	check_close(gdwg::betweenness_centrality(g), {0, 1, 0, 0});
+}
+
+TEST_CASE("betweenness: agrees with the definition on random graphs") {
+	auto serial = gdwg::thread_pool(1);
+	auto parallel = gdwg::thread_pool(4);
+	for (auto const node_count : {2, 12, 40}) {
+		for (auto round = 0u; round < 5; ++round) {
+			auto const weighted = gdwg_test::random_graph(node_count, 3 * node_count, round, 1, 4);
+			auto const plain = gdwg_test::unweighted(weighted);
+
+			auto const frozen = gdwg::frozen_graph<int, int>(weighted);
+			auto const expected = reference_betweenness(frozen);
+			check_close(gdwg::betweenness_centrality(frozen, {}, serial), expected);
+			check_close(gdwg::betweenness_centrality(frozen, {}, parallel), expected);
+
+			auto const hops = gdwg::frozen_graph<int, void>(plain);
+			check_close(gdwg::betweenness_centrality(hops, {}, parallel), reference_betweenness(hops));
+		}
+	}
+}
+
+TEST_CASE("betweenness: sampled sources estimate the exact scores") {
+	auto const g = gdwg_test::random_graph(60, 240, 6771);
+	auto const frozen = gdwg::frozen_graph<int, void>(g);
+	auto pool = gdwg::thread_pool(4);
+	auto const exact = gdwg::betweenness_centrality(frozen, {}, pool);
+
+	// sampling every node is exact, whatever the seed
+	check_close(gdwg::betweenness_centrality(frozen, {.samples = 60, .seed = 3}, pool), exact);
+
+	auto const options = gdwg::betweenness_options{.samples = 10, .seed = 42};
+	auto const sampled = gdwg::betweenness_centrality(frozen, options, pool);
+	check_close(gdwg::betweenness_centrality(frozen, options, gdwg::default_thread_pool()), sampled);
+	CHECK(sampled != gdwg::betweenness_centrality(frozen, {.samples = 10, .seed = 43}, pool));
+
+	// the estimate is unbiased, so averaging many samples comes close to the exact total
+	auto average = 0.0;
+	auto const seeds = 200;
+	for (auto seed = 0; seed < seeds; ++seed) {
+		auto const estimate = gdwg::betweenness_centrality(
+		   frozen,
+		   {.samples = 10, .seed = static_cast<std::uint64_t>(seed)},
+		   pool);
+		average += std::accumulate(estimate.begin(), estimate.end(), 0.0) / seeds;
+	}
+	CHECK(average == Approx(std::accumulate(exact.begin(), exact.end(), 0.0)).epsilon(0.05));
+}
@@ -0,0 +1,122 @@
+#include "gdwg/random_walk.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("walk sampler: steps follow out-edges in proportion to their weight") {
+	auto g = gdwg::graph<std::string, double>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("a", "d", 3.5);
+	g.insert_edge("a", "d", 0.5);
+	g.insert_edge("a", "e", 0);
+	g.insert_edge("b", "a", 0);
+	g.insert_edge("c", "c", 2);
+
+	auto const sampler = gdwg::walk_sampler(g);
+	REQUIRE(sampler.size() == 6);
+	auto engine = std::mt19937_64(6771);
+	auto counts = std::vector<int>(6);
+	auto const steps = 70000;
+	for (auto i = 0; i < steps; ++i) {
+		++counts[sampler.step(0, engine)];
+	}
+	CHECK(counts[1] == Approx(steps / 7.0).epsilon(0.05));
+	CHECK(counts[2] == Approx(2 * steps / 7.0).epsilon(0.05));
+	CHECK(counts[3] == Approx(4 * steps / 7.0).epsilon(0.05));
+	CHECK(counts[4] == 0);
+
+	// only zero-weight edges, or none at all, end the walk; a self-loop never does
+	CHECK(sampler.step(1, engine) == gdwg::no_rank);
+	CHECK(sampler.step(5, engine) == gdwg::no_rank);
+	CHECK(sampler.step(2, engine) == 2);
+
+	g.insert_edge("f", "a", -1);
+	REQUIRE_THROWS_WITH(gdwg::walk_sampler(g),
+	                    "Cannot call gdwg::walk_sampler on a graph with negative edge weights");
+}
+
+TEST_CASE("walk sampler: unweighted graphs step uniformly") {
+	auto g = gdwg::graph<int, void>{0, 1, 2, 3, 4};
+	for (auto to = 1; to <= 4; ++to) {
+		g.insert_edge(0, to);
+		g.insert_edge(to, 0);
+	}
+	auto const sampler = gdwg::walk_sampler(g);
+	auto engine = std::minstd_rand(6771);
+	auto counts = std::vector<int>(5);
+	for (auto i = 0; i < 40000; ++i) {
+		++counts[sampler.step(0, engine)];
+	}
+	CHECK(counts[0] == 0);
+	for (auto to = 1; to <= 4; ++to) {
+		CHECK(counts[static_cast<std::size_t>(to)] == Approx(10000).epsilon(0.05));
+	}
+}
+
+TEST_CASE("walk sampler: batches of walks are reproducible whatever the pool") {
+	auto const node_count = 300;
+	auto const g = gdwg_test::random_graph(node_count, 3 * node_count, 6771, 0, 5);
+	auto engine = std::mt19937(6771);
+	auto const frozen = gdwg::frozen_graph<int, int>(g);
+
+	auto serial = gdwg::thread_pool(1);
+	auto parallel = gdwg::thread_pool(4);
+	auto const sampler = gdwg::walk_sampler(frozen, parallel);
+	auto const walks = sampler.walks_from_each_node(3, 20, 42, parallel);
+	REQUIRE(walks.count() == 3 * node_count);
+	CHECK(walks.nodes == sampler.walks_from_each_node(3, 20, 42, serial).nodes);
+	auto const rebuilt = gdwg::walk_sampler(g, serial);
+	CHECK(walks.nodes == rebuilt.walks_from_each_node(3, 20, 42, parallel).nodes);
+	CHECK(walks.nodes != sampler.walks_from_each_node(3, 20, 43, parallel).nodes);
+
+	// every step is along an edge of positive weight, and walks only stop at dead ends
+	for (auto walk = std::size_t{0}; walk < walks.count(); ++walk) {
+		auto const nodes = walks[walk];
+		CHECK(nodes[0] == walk % node_count);
+		for (auto i = std::size_t{1}; i < nodes.size() && nodes[i] != gdwg::no_rank; ++i) {
+			auto const neighbours = frozen.out_neighbours(nodes[i - 1]);
+			auto const weights = frozen.out_weights(nodes[i - 1]);
+			auto followed = false;
+			for (auto j = std::size_t{0}; j < neighbours.size(); ++j) {
+				followed = followed || (neighbours[j] == nodes[i] && weights[j] > 0);
+			}
+			CHECK(followed);
+		}
+		auto const end = std::find(nodes.begin(), nodes.end(), gdwg::no_rank);
+		if (end != nodes.end()) {
+			CHECK(sampler.step(*(end - 1), engine) == gdwg::no_rank);
+			CHECK(std::all_of(end, nodes.end(), [](auto rank) { return rank == gdwg::no_rank; }));
+		}
+	}
+
+	auto const starts = std::vector<std::size_t>{7, 7, 0, 299};
+	auto const chosen = sampler.walks(starts, 5, 42, parallel);
+	REQUIRE(chosen.count() == 4);
+	for (auto walk = std::size_t{0}; walk < starts.size(); ++walk) {
+		CHECK(chosen[walk][0] == starts[walk]);
+	}
+	CHECK(sampler.walks(starts, 0, 42).count() == 0);
+
+	// consecutive seeds draw afresh rather than shifting each other's walks along by one
+	auto const same_start = std::vector<std::size_t>(40, 7);
+	auto const seed_walks = sampler.walks(same_start, 20, 42, parallel);
+	auto const next_seed_walks = sampler.walks(same_start, 20, 43, parallel);
+	auto shifted = 0;
+	for (auto walk = std::size_t{0}; walk + 1 < same_start.size(); ++walk) {
+		auto const lhs = seed_walks[walk + 1];
+		auto const rhs = next_seed_walks[walk];
+		shifted += static_cast<int>(std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+	CHECK(shifted < 3);
+
+	REQUIRE_THROWS_WITH(sampler.walks({300}, 5, 42),
+	                    "Cannot call gdwg::walk_sampler::walks with a start node that doesn't exist "
+	                    "in the graph");
+}
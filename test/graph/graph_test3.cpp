@@ -1,6 +1,7 @@
 #include "gdwg/graph.hpp"
 
 #include <catch2/catch.hpp>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -104,4 +105,78 @@ TEST_CASE("connections test") {
 	CHECK(graph1.connections("a") == expected_conn_a);
 	CHECK(graph1.connections("b") == expected_conn_b);
 	CHECK(graph1.connections("c") == expected_conn_c);
-}
\ No newline at end of file
+}
+
+TEST_CASE("induced_subgraph test") {
+	auto graph1 = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+
+	graph1.insert_edge("a", "b", 1);
+	graph1.insert_edge("a", "b", 4);
+	graph1.insert_edge("b", "a", 2);
+	graph1.insert_edge("a", "c", 3);
+	graph1.insert_edge("c", "c", 5);
+	graph1.insert_edge("d", "a", 6);
+
+	auto const kept = std::vector<std::string>{"c", "a", "b", "a"};
+	auto const graph2 = graph1.induced_subgraph(kept.begin(), kept.end());
+
+	auto expected = gdwg::graph<std::string, int>{"a", "b", "c"};
+	expected.insert_edge("a", "b", 1);
+	expected.insert_edge("a", "b", 4);
+	expected.insert_edge("b", "a", 2);
+	expected.insert_edge("a", "c", 3);
+	expected.insert_edge("c", "c", 5);
+	CHECK(graph2 == expected);
+	CHECK(graph1.is_node("d"));
+
+	auto const none = std::vector<std::string>{};
+	CHECK(graph1.induced_subgraph(none.begin(), none.end()).empty());
+	auto const missing = std::vector<std::string>{"a", "e"};
+	REQUIRE_THROWS_WITH(graph1.induced_subgraph(missing.begin(), missing.end()),
+	                    "Cannot call gdwg::graph<N, E>::induced_subgraph on nodes that don't exist "
+	                    "in the graph");
+
+	constexpr auto lowest = std::numeric_limits<int>::min();
+	constexpr auto highest = std::numeric_limits<int>::max();
+	auto graph3 = gdwg::graph<int, void>{lowest, -1, 0, 1, highest};
+	graph3.insert_edge(lowest, highest);
+	graph3.insert_edge(-1, 1);
+	graph3.insert_edge(1, -1);
+	graph3.insert_edge(0, lowest);
+	graph3.insert_edge(highest, 0);
+
+	auto const close = std::vector<int>{1, -1, 0};
+	auto expected_close = gdwg::graph<int, void>{-1, 0, 1};
+	expected_close.insert_edge(-1, 1);
+	expected_close.insert_edge(1, -1);
+	CHECK(graph3.induced_subgraph(close.begin(), close.end()) == expected_close);
+
+	auto const far = std::vector<int>{highest, 0, lowest};
+	auto expected_far = gdwg::graph<int, void>{lowest, 0, highest};
+	expected_far.insert_edge(lowest, highest);
+	expected_far.insert_edge(0, lowest);
+	expected_far.insert_edge(highest, 0);
+	CHECK(graph3.induced_subgraph(far.begin(), far.end()) == expected_far);
+}
+
+TEST_CASE("transpose test") {
+	auto graph1 = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+
+	graph1.insert_edge("a", "b", 4);
+	graph1.insert_edge("a", "b", 1);
+	graph1.insert_edge("b", "a", 2);
+	graph1.insert_edge("a", "c", 3);
+	graph1.insert_edge("c", "c", 5);
+
+	auto expected = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	expected.insert_edge("b", "a", 4);
+	expected.insert_edge("b", "a", 1);
+	expected.insert_edge("a", "b", 2);
+	expected.insert_edge("c", "a", 3);
+	expected.insert_edge("c", "c", 5);
+
+	auto const graph2 = graph1.transpose();
+	CHECK(graph2 == expected);
+	CHECK(graph2.transpose() == graph1);
+	CHECK(gdwg::graph<std::string, int>{}.transpose().empty());
+}
@@ -0,0 +1,207 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dense_graph = gdwg::graph<int, int, gdwg::dense_storage>;
+
+TEST_CASE("dense storage: iterator is bidirectional") {
+	STATIC_REQUIRE(std::bidirectional_iterator<dense_graph::iterator>);
+	STATIC_REQUIRE(std::bidirectional_iterator<gdwg::graph<int, int>::iterator>);
+}
+
+TEST_CASE("dense storage: nodes are sorted regardless of insertion order") {
+	auto graph1 = dense_graph{};
+	CHECK(graph1.empty());
+
+	CHECK(graph1.insert_node(5));
+	CHECK(graph1.insert_node(-3));
+	CHECK(graph1.insert_node(200));
+	CHECK(graph1.insert_node(0));
+	CHECK(!graph1.insert_node(5));
+
+	auto const expected_nodes = std::vector<int>{-3, 0, 5, 200};
+	CHECK(graph1.nodes() == expected_nodes);
+	CHECK(graph1.is_node(-3));
+	CHECK(!graph1.is_node(-4));
+	CHECK(!graph1.is_node(1));
+	CHECK(!graph1.is_node(201));
+}
+
+TEST_CASE("dense storage: extreme node values") {
+	auto graph1 = gdwg::graph<std::int8_t, int, gdwg::dense_storage>{};
+	graph1.insert_node(127);
+	graph1.insert_node(-128);
+	graph1.insert_node(0);
+	graph1.insert_edge(127, -128, 1);
+
+	auto const expected_nodes = std::vector<std::int8_t>{-128, 0, 127};
+	CHECK(graph1.nodes() == expected_nodes);
+	CHECK(graph1.is_connected(127, -128));
+}
+
+TEST_CASE("dense storage: node values too far apart to index") {
+	constexpr auto lowest = std::numeric_limits<std::int64_t>::min();
+	constexpr auto highest = std::numeric_limits<std::int64_t>::max();
+	auto const message = "Cannot call gdwg::graph<N, E>::insert_node with gdwg::dense_storage on "
+	                     "node values spread too far apart";
+
+	auto graph1 = gdwg::graph<std::int64_t, int, gdwg::dense_storage>{0};
+	REQUIRE_THROWS_WITH(graph1.insert_node(highest), message);
+	REQUIRE_THROWS_WITH(graph1.insert_node(lowest), message);
+	CHECK_THROWS_AS(graph1.insert_node(highest), std::length_error);
+	CHECK(graph1.nodes() == std::vector<std::int64_t>{0});
+
+	// a full 64-bit span would overflow the slot count itself
+	auto graph2 = gdwg::graph<std::uint64_t, int, gdwg::dense_storage>{0};
+	REQUIRE_THROWS_WITH(graph2.insert_node(std::numeric_limits<std::uint64_t>::max()), message);
+	CHECK(graph2.insert_node(1000));
+	CHECK(graph2.nodes() == std::vector<std::uint64_t>{0, 1000});
+}
+
+TEST_CASE("dense storage: iteration matches tree storage") {
+	auto dense = dense_graph{1, 7, 12, 14, 19, 21, 31, 67};
+	auto tree = gdwg::graph<int, int>{1, 7, 12, 14, 19, 21, 31, 67};
+	auto const edges = std::vector<gdwg::graph<int, int>::value_type>{
+	   {7, 21, 13},
+	   {12, 19, 16},
+	   {14, 14, 0},
+	   {19, 1, 3},
+	   {19, 21, 2},
+	   {21, 14, 23},
+	   {21, 31, 14},
+	   {1, 7, 4},
+	   {1, 12, 3},
+	   {1, 21, 12},
+	   {1, 21, 1},
+	};
+	for (auto const& [from, to, weight] : edges) {
+		dense.insert_edge(from, to, weight);
+		tree.insert_edge(from, to, weight);
+	}
+
+	auto dense_out = std::ostringstream{};
+	auto tree_out = std::ostringstream{};
+	dense_out << dense;
+	tree_out << tree;
+	CHECK(dense_out.str() == tree_out.str());
+
+	auto tree_it = tree.begin();
+	for (auto const& [from, to, weight] : dense) {
+		REQUIRE(tree_it != tree.end());
+		CHECK(from == (*tree_it).from);
+		CHECK(to == (*tree_it).to);
+		CHECK(weight == (*tree_it).weight);
+		++tree_it;
+	}
+	CHECK(tree_it == tree.end());
+
+	auto dense_it = dense.end();
+	for (auto count = std::distance(tree.begin(), tree.end()); count > 0; --count) {
+		--dense_it;
+		--tree_it;
+		CHECK((*dense_it).from == (*tree_it).from);
+		CHECK((*dense_it).to == (*tree_it).to);
+		CHECK((*dense_it).weight == (*tree_it).weight);
+	}
+	CHECK(dense_it == dense.begin());
+}
+
+TEST_CASE("dense storage: accessors") {
+	auto graph1 = dense_graph{1, 2, 3};
+	graph1.insert_edge(1, 2, 10);
+	graph1.insert_edge(1, 2, 1);
+	graph1.insert_edge(1, 3, 5);
+
+	CHECK(!graph1.insert_edge(1, 2, 1));
+	CHECK(graph1.weights(1, 2) == std::vector<int>{1, 10});
+	CHECK(graph1.connections(1) == std::vector<int>{2, 3});
+	CHECK(graph1.is_connected(1, 3));
+	CHECK(!graph1.is_connected(3, 1));
+	CHECK(graph1.find(1, 2, 10) != graph1.end());
+	CHECK(graph1.find(1, 2, 5) == graph1.end());
+	REQUIRE_THROWS_WITH(graph1.insert_edge(1, 4, 1),
+	                    "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+	                    "does not exist");
+}
+
+TEST_CASE("dense storage: erase_node removes incoming and outgoing edges") {
+	auto graph1 = dense_graph{1, 2, 3};
+	graph1.insert_edge(1, 2, 1);
+	graph1.insert_edge(2, 3, 2);
+	graph1.insert_edge(3, 2, 3);
+	graph1.insert_edge(3, 1, 4);
+
+	CHECK(graph1.erase_node(2));
+	CHECK(!graph1.erase_node(2));
+	CHECK(graph1.nodes() == std::vector<int>{1, 3});
+	CHECK(graph1.connections(1).empty());
+	CHECK(graph1.connections(3) == std::vector<int>{1});
+
+	CHECK(graph1.erase_node(1));
+	CHECK(graph1.erase_node(3));
+	CHECK(graph1.empty());
+	CHECK(graph1.begin() == graph1.end());
+}
+
+TEST_CASE("dense storage: replace and merge nodes") {
+	auto graph1 = dense_graph{1, 2, 3, 4};
+	graph1.insert_edge(1, 2, 1);
+	graph1.insert_edge(1, 3, 2);
+	graph1.insert_edge(1, 4, 3);
+	graph1.insert_edge(2, 2, 1);
+
+	graph1.merge_replace_node(1, 2);
+	auto expected = dense_graph{2, 3, 4};
+	expected.insert_edge(2, 2, 1);
+	expected.insert_edge(2, 3, 2);
+	expected.insert_edge(2, 4, 3);
+	CHECK(graph1 == expected);
+
+	CHECK(graph1.replace_node(2, -10));
+	CHECK(!graph1.replace_node(3, 4));
+	CHECK(graph1.nodes() == std::vector<int>{-10, 3, 4});
+	CHECK(graph1.weights(-10, -10) == std::vector<int>{1});
+	CHECK(graph1.weights(-10, 4) == std::vector<int>{3});
+}
+
+TEST_CASE("dense storage: erase edges through iterators") {
+	auto graph1 = dense_graph{1, 2, 3};
+	graph1.insert_edge(1, 2, 1);
+	graph1.insert_edge(1, 3, 2);
+	graph1.insert_edge(1, 3, 3);
+	graph1.insert_edge(3, 1, 4);
+
+	auto next = graph1.erase_edge(graph1.find(1, 3, 2));
+	CHECK((*next).to == 3);
+	CHECK((*next).weight == 3);
+
+	auto last = graph1.find(3, 1, 4);
+	auto result = graph1.erase_edge(graph1.begin(), last);
+	REQUIRE(result != graph1.end());
+	CHECK((*result).from == 3);
+	CHECK(std::distance(graph1.begin(), graph1.end()) == 1);
+
+	CHECK(graph1.erase_edge(3, 1, 4));
+	CHECK(!graph1.erase_edge(3, 1, 4));
+	CHECK(graph1.begin() == graph1.end());
+}
+
+TEST_CASE("dense storage: copy and move") {
+	auto graph1 = dense_graph{1, 2};
+	graph1.insert_edge(1, 2, 7);
+
+	auto graph2 = graph1;
+	CHECK(graph2 == graph1);
+
+	auto graph3 = std::move(graph1);
+	CHECK(graph1.empty());
+	CHECK(graph3 == graph2);
+	CHECK(graph3.is_connected(1, 2));
+}
@@ -0,0 +1,96 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using topology = gdwg::graph<std::string, void>;
+
+TEST_CASE("unweighted: value_type only has from and to") {
+	STATIC_REQUIRE(sizeof(gdwg::graph<int, void>::value_type) == 2 * sizeof(int));
+	STATIC_REQUIRE(std::bidirectional_iterator<topology::iterator>);
+}
+
+TEST_CASE("unweighted: insert, find and erase edges by src and dst") {
+	auto graph1 = topology{"a", "b", "c"};
+
+	CHECK(graph1.insert_edge("a", "b"));
+	CHECK(graph1.insert_edge("a", "c"));
+	CHECK(graph1.insert_edge("c", "c"));
+	CHECK(!graph1.insert_edge("a", "b"));
+	REQUIRE_THROWS_WITH(graph1.insert_edge("a", "x"),
+	                    "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+	                    "does not exist");
+
+	CHECK(graph1.find("a", "c") != graph1.end());
+	CHECK(graph1.find("b", "a") == graph1.end());
+	CHECK(graph1.is_connected("a", "b"));
+	CHECK(graph1.connections("a") == std::vector<std::string>{"b", "c"});
+
+	CHECK(graph1.erase_edge("a", "b"));
+	CHECK(!graph1.erase_edge("a", "b"));
+	CHECK(!graph1.is_connected("a", "b"));
+	REQUIRE_THROWS_WITH(graph1.erase_edge("a", "x"),
+	                    "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't exist "
+	                    "in the graph");
+}
+
+TEST_CASE("unweighted: iteration yields from and to") {
+	auto graph1 = topology{"a", "b", "c"};
+	graph1.insert_edge("b", "a");
+	graph1.insert_edge("a", "c");
+	graph1.insert_edge("a", "b");
+
+	auto const expected_from = std::vector<std::string>{"a", "a", "b"};
+	auto const expected_to = std::vector<std::string>{"b", "c", "a"};
+	auto actual_from = std::vector<std::string>{};
+	auto actual_to = std::vector<std::string>{};
+	for (auto const& [from, to] : graph1) {
+		actual_from.push_back(from);
+		actual_to.push_back(to);
+	}
+	CHECK(actual_from == expected_from);
+	CHECK(actual_to == expected_to);
+}
+
+TEST_CASE("unweighted: replace, merge and erase nodes") {
+	auto graph1 = topology{"a", "b", "c"};
+	graph1.insert_edge("a", "b");
+	graph1.insert_edge("c", "a");
+	graph1.insert_edge("b", "b");
+
+	CHECK(graph1.replace_node("a", "z"));
+	CHECK(graph1.is_connected("z", "b"));
+	CHECK(graph1.is_connected("c", "z"));
+
+	graph1.merge_replace_node("z", "b");
+	auto expected = topology{"b", "c"};
+	expected.insert_edge("b", "b");
+	expected.insert_edge("c", "b");
+	CHECK(graph1 == expected);
+
+	CHECK(graph1.erase_node("b"));
+	CHECK(graph1.begin() == graph1.end());
+}
+
+TEST_CASE("unweighted: extractor omits weights") {
+	auto graph1 = gdwg::graph<int, void, gdwg::dense_storage>{1, 2, 3};
+	graph1.insert_edge(1, 2);
+	graph1.insert_edge(1, 3);
+	graph1.insert_edge(3, 3);
+
+	auto const expected_output = std::string_view(R"(1 (
+  2
+  3
+)
+2 (
+)
+3 (
+  3
+)
+)");
+	auto out = std::ostringstream{};
+	out << graph1;
+	CHECK(out.str() == expected_output);
+}
@@ -0,0 +1,220 @@
+#include "gdwg/graph.hpp"
+#include "random_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	// A user-provided policy only needs a nested storage<N, E> modelling gdwg::graph_storage.
+	struct forwarding_storage {
+		template<typename N, typename E>
+		using storage = gdwg::tree_storage::storage<N, E>;
+	};
+
+	// Hides the optional append_node and append_edge, so the graph falls back on inserting.
+	struct insert_only_storage {
+		template<typename N, typename E>
+		struct storage : gdwg::tree_storage::storage<N, E> {
+			using base = gdwg::tree_storage::storage<N, E>;
+
+			auto append_node(N const&) -> void = delete;
+			auto append_edge(typename base::node_iterator,
+			                 typename base::node_iterator,
+			                 E const&) -> void = delete;
+		};
+	};
+
+	struct incomplete_storage {
+		template<typename N, typename E>
+		struct storage {
+			using node_iterator = int*;
+			using edge_iterator = int*;
+		};
+	};
+} // namespace
+
+TEST_CASE("storage policies: user-provided policies are checked against graph_storage") {
+	STATIC_REQUIRE(gdwg::graph_storage<forwarding_storage::storage<int, int>, int, int>);
+	STATIC_REQUIRE(!gdwg::graph_storage<incomplete_storage::storage<int, int>, int, int>);
+
+	auto graph1 = gdwg::graph<std::string, int, forwarding_storage>{"a", "b"};
+	CHECK(graph1.insert_edge("a", "b", 1));
+	CHECK(graph1.is_connected("a", "b"));
+}
+
+TEMPLATE_TEST_CASE("storage policies: nodes and edges",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage,
+                   gdwg::dense_storage) {
+	STATIC_REQUIRE(std::bidirectional_iterator<typename gdwg::graph<int, int, TestType>::iterator>);
+
+	auto graph1 = gdwg::graph<int, int, TestType>{4, 1, 3};
+	CHECK(graph1.insert_node(2));
+	CHECK(!graph1.insert_node(4));
+	CHECK(graph1.nodes() == std::vector<int>{1, 2, 3, 4});
+
+	CHECK(graph1.insert_edge(4, 1, -4));
+	CHECK(graph1.insert_edge(2, 4, 2));
+	CHECK(graph1.insert_edge(2, 1, 1));
+	CHECK(graph1.insert_edge(2, 1, 0));
+	CHECK(graph1.insert_edge(3, 3, 5));
+	CHECK(!graph1.insert_edge(2, 1, 1));
+
+	auto const expected_output = std::string_view(R"(1 (
+)
+2 (
+  1 | 0
+  1 | 1
+  4 | 2
+)
+3 (
+  3 | 5
+)
+4 (
+  1 | -4
+)
+)");
+	auto out = std::ostringstream{};
+	out << graph1;
+	CHECK(out.str() == expected_output);
+
+	CHECK(graph1.weights(2, 1) == std::vector<int>{0, 1});
+	CHECK(graph1.connections(2) == std::vector<int>{1, 4});
+	CHECK(graph1.find(3, 3, 5) != graph1.end());
+	CHECK(graph1.find(3, 3, 6) == graph1.end());
+
+	auto copy = graph1;
+	CHECK(copy == graph1);
+
+	CHECK(graph1.erase_node(1));
+	CHECK(graph1.connections(2) == std::vector<int>{4});
+	CHECK(graph1.connections(4).empty());
+	CHECK(copy.is_connected(4, 1));
+	CHECK(!(copy == graph1));
+
+	CHECK(graph1.replace_node(3, 5));
+	CHECK(graph1.nodes() == std::vector<int>{2, 4, 5});
+	CHECK(graph1.weights(5, 5) == std::vector<int>{5});
+
+	graph1.merge_replace_node(2, 5);
+	CHECK(graph1.nodes() == std::vector<int>{4, 5});
+	CHECK(graph1.weights(5, 4) == std::vector<int>{2});
+
+	graph1.erase_edge(graph1.begin(), graph1.end());
+	CHECK(graph1.begin() == graph1.end());
+	CHECK(graph1.nodes() == std::vector<int>{4, 5});
+
+	graph1.clear();
+	CHECK(graph1.empty());
+}
+
+TEMPLATE_TEST_CASE("storage policies: string nodes",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage) {
+	auto graph1 = gdwg::graph<std::string, int, TestType>{"c", "a", "b"};
+	graph1.insert_edge("b", "b", 1);
+	graph1.insert_edge("b", "a", 2);
+	graph1.insert_edge("b", "c", 3);
+	graph1.insert_edge("c", "a", 4);
+
+	auto moved = std::move(graph1);
+	CHECK(graph1.empty());
+	CHECK(moved.nodes() == std::vector<std::string>{"a", "b", "c"});
+
+	auto const expected_from = std::vector<std::string>{"b", "b", "b", "c"};
+	auto const expected_to = std::vector<std::string>{"a", "b", "c", "a"};
+	auto actual_from = std::vector<std::string>{};
+	auto actual_to = std::vector<std::string>{};
+	for (auto const& [from, to, weight] : moved) {
+		actual_from.push_back(from);
+		actual_to.push_back(to);
+	}
+	CHECK(actual_from == expected_from);
+	CHECK(actual_to == expected_to);
+
+	auto last = moved.end();
+	--last;
+	CHECK((*last).weight == 4);
+	auto const next = moved.erase_edge(moved.find("b", "a", 2));
+	CHECK(next == moved.find("b", "b", 1));
+}
+
+TEMPLATE_TEST_CASE("storage policies: induced subgraphs",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage,
+                   gdwg::dense_storage,
+                   insert_only_storage) {
+	auto const graph1 = gdwg_test::random_graph<TestType>(100, 600, 6771, -3, 3);
+	auto engine = std::mt19937(6771);
+	auto node = std::uniform_int_distribution<int>(0, 99);
+	auto kept = std::vector<int>{};
+	for (auto i = 0; i < 40; ++i) {
+		kept.push_back(node(engine));
+	}
+
+	// the slow way: copy the whole graph and erase everything else
+	auto const erase_others = [&graph1](std::vector<int> const& nodes) {
+		auto result = graph1;
+		for (auto i = 0; i < 100; ++i) {
+			if (std::find(nodes.begin(), nodes.end(), i) == nodes.end()) {
+				result.erase_node(i);
+			}
+		}
+		return result;
+	};
+	auto subgraph = graph1.induced_subgraph(kept.begin(), kept.end());
+	auto expected = erase_others(kept);
+	CHECK(subgraph == expected);
+
+	// too few nodes for their spread to be worth a table of ranks
+	auto const spread = std::vector<int>{97, 3, 50, 0, 3};
+	CHECK(graph1.induced_subgraph(spread.begin(), spread.end()) == erase_others(spread));
+
+	// the appended nodes and edges are indexed like inserted ones
+	for (auto* const g : {&subgraph, &expected}) {
+		g->insert_node(-1);
+		g->insert_edge(-1, kept.front(), 0);
+		g->insert_edge(kept.back(), -1, 0);
+	}
+	CHECK(subgraph == expected);
+}
+
+TEMPLATE_TEST_CASE("storage policies: transposed graphs",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage,
+                   gdwg::dense_storage,
+                   insert_only_storage) {
+	auto const graph1 = gdwg_test::random_graph<TestType>(100, 600, 6771, -3, 3);
+	auto const hops = gdwg_test::unweighted(graph1);
+	auto const nodes = graph1.nodes();
+	auto reversed = gdwg::graph<int, int, TestType>(nodes.begin(), nodes.end());
+	auto reversed_hops = gdwg::graph<int, void, TestType>(nodes.begin(), nodes.end());
+	for (auto const& [from, to, w] : graph1) {
+		reversed.insert_edge(to, from, w);
+		reversed_hops.insert_edge(to, from);
+	}
+
+	auto transposed = graph1.transpose();
+	CHECK(transposed == reversed);
+	CHECK(transposed.transpose() == graph1);
+	CHECK(hops.transpose() == reversed_hops);
+
+	// the appended edges are indexed like inserted ones
+	for (auto* const g : {&transposed, &reversed}) {
+		g->insert_edge(5, 7, 10);
+		g->erase_edge(g->begin());
+	}
+	CHECK(transposed == reversed);
+}
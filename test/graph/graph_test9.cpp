@@ -0,0 +1,149 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A string node that counts how many times one is constructed.
+struct counted_name {
+	static inline auto constructed = 0;
+
+	explicit counted_name(std::string_view name)
+	: value(name) {
+		++constructed;
+	}
+
+	counted_name(counted_name const& other)
+	: value(other.value) {
+		++constructed;
+	}
+
+	operator std::string_view() const noexcept {
+		return value;
+	}
+
+	friend auto operator==(counted_name const&, counted_name const&) -> bool = default;
+	friend auto operator<=>(counted_name const&, counted_name const&) = default;
+
+	friend auto operator==(counted_name const& lhs, std::string_view rhs) -> bool {
+		return lhs.value == rhs;
+	}
+
+	friend auto operator<=>(counted_name const& lhs, std::string_view rhs) {
+		return std::string_view(lhs.value) <=> rhs;
+	}
+
+	std::string value;
+};
+
+constexpr auto long_name = std::string_view("a node name that does not fit in the small buffer");
+
+TEMPLATE_TEST_CASE("heterogeneous keys: string_view and char const* find string nodes",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage) {
+	auto graph1 = gdwg::graph<std::string, int, TestType>{"a", "b", std::string(long_name)};
+	graph1.insert_edge(std::string_view("a"), "b", 1);
+	graph1.insert_edge("a", long_name, 2);
+	graph1.insert_edge(long_name, long_name, 3);
+
+	auto const b = std::string_view("b");
+	char const* const a = "a";
+	CHECK(graph1.is_node(b));
+	CHECK(graph1.is_node(a));
+	CHECK(!graph1.is_node(std::string_view("c")));
+	CHECK(graph1.is_connected(a, b));
+	CHECK(!graph1.is_connected(b, a));
+	CHECK(graph1.weights(a, long_name) == std::vector<int>{2});
+	CHECK(graph1.connections(a) == std::vector<std::string>{std::string(long_name), "b"});
+	CHECK(graph1.find(long_name, long_name, 3) != graph1.end());
+	CHECK(graph1.find(a, b, 3) == graph1.end());
+
+	REQUIRE_THROWS_WITH(graph1.weights(a, std::string_view("c")),
+	                    "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist in "
+	                    "the graph");
+	REQUIRE_THROWS_WITH(graph1.connections(std::string_view("c")),
+	                    "Cannot call gdwg::graph<N, E>::connections if src doesn't exist in the "
+	                    "graph");
+
+	CHECK(graph1.erase_edge(a, b, 1));
+	CHECK(!graph1.erase_edge(a, b, 1));
+	CHECK(graph1.erase_node(long_name));
+	CHECK(!graph1.erase_node(long_name));
+	CHECK(graph1.nodes() == std::vector<std::string>{"a", "b"});
+}
+
+TEMPLATE_TEST_CASE("heterogeneous keys: lookups do not construct a node",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage) {
+	auto graph1 = gdwg::graph<counted_name, int, TestType>{counted_name("a"), counted_name("b")};
+	graph1.insert_edge(counted_name("a"), counted_name("b"), 1);
+
+	counted_name::constructed = 0;
+	auto const a = std::string_view("a");
+	CHECK(graph1.is_node(a));
+	CHECK(!graph1.is_node(std::string_view("c")));
+	CHECK(graph1.is_connected(a, std::string_view("b")));
+	CHECK(graph1.find(a, std::string_view("b"), 1) != graph1.end());
+	CHECK(graph1.weights(a, std::string_view("b")) == std::vector<int>{1});
+	CHECK(graph1.erase_edge(a, std::string_view("b"), 1));
+	CHECK(counted_name::constructed == 0);
+}
+
+TEMPLATE_TEST_CASE("heterogeneous keys: wider integers never wrap onto a node",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::dense_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage) {
+	auto graph1 = gdwg::graph<std::int8_t, int, TestType>{-1, 0, 1};
+	graph1.insert_edge(1, -1, 5);
+
+	CHECK(graph1.is_node(std::int64_t{-1}));
+	CHECK(graph1.is_connected(std::int64_t{1}, -1L));
+	CHECK(!graph1.is_node(257));
+	CHECK(!graph1.is_node(-255L));
+	CHECK(!graph1.is_node(std::uint64_t{0xFFFF'FFFF'FFFF'FFFF}));
+	CHECK(!graph1.erase_node(256));
+	CHECK(graph1.nodes() == std::vector<std::int8_t>{-1, 0, 1});
+
+	auto unsigned_graph = gdwg::graph<std::uint32_t, int, TestType>{0U, 1U};
+	CHECK(unsigned_graph.is_node(std::int64_t{1}));
+	CHECK(!unsigned_graph.is_node(std::int64_t{0x1'0000'0001}));
+	CHECK(!unsigned_graph.is_node(-1));
+}
+
+TEMPLATE_TEST_CASE("heterogeneous keys: floating keys only find nodes they equal exactly",
+                   "",
+                   gdwg::tree_storage,
+                   gdwg::dense_storage,
+                   gdwg::flat_storage,
+                   gdwg::hash_storage) {
+	auto graph1 = gdwg::graph<int, int, TestType>{-2, 1, 2};
+	graph1.insert_edge(1, 2, 5);
+
+	CHECK(graph1.is_node(1.0));
+	CHECK(graph1.is_node(-2.0F));
+	CHECK(graph1.is_connected(1.0, 2));
+	CHECK(!graph1.is_node(1.5));
+	CHECK(!graph1.is_node(-1.5));
+	CHECK(!graph1.is_node(2.000001));
+	CHECK(!graph1.is_node(1e300));
+	CHECK(!graph1.is_node(-std::numeric_limits<double>::infinity()));
+	CHECK(!graph1.is_node(std::numeric_limits<double>::quiet_NaN()));
+	CHECK(!graph1.erase_node(1.5));
+	CHECK(graph1.nodes() == std::vector<int>{-2, 1, 2});
+
+	auto unsigned_graph = gdwg::graph<std::uint64_t, int, TestType>{0U, 1U};
+	CHECK(unsigned_graph.is_node(0.0));
+	CHECK(unsigned_graph.is_node(-0.0));
+	CHECK(!unsigned_graph.is_node(-1.0));
+	CHECK(!unsigned_graph.is_node(18446744073709551616.0));
+}
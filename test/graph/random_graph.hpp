@@ -0,0 +1,70 @@
+#ifndef GDWG_TEST_RANDOM_GRAPH_HPP
+#define GDWG_TEST_RANDOM_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <random>
+#include <type_traits>
+
+// Random graphs for the tests that check algorithms against a reference on many inputs.
+namespace gdwg_test {
+	// A graph with nodes 0 .. node_count - 1 and edge_count edges, each between two nodes drawn
+	// uniformly at random, so there may be self-loops and parallel edges. Weights are drawn
+	// uniformly from [lowest, highest]. A drawn edge that is already in the graph is skipped, so
+	// there may be fewer than edge_count edges. The same arguments always give the same graph.
+	template<typename Storage = gdwg::tree_storage, typename E>
+	auto random_graph(int node_count, int edge_count, unsigned seed, E lowest, E highest)
+	   -> gdwg::graph<int, E, Storage> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+		auto weight = [&] {
+			if constexpr (std::is_integral_v<E>) {
+				return std::uniform_int_distribution<E>(lowest, highest);
+			}
+			else {
+				return std::uniform_real_distribution<E>(lowest, highest);
+			}
+		}();
+		auto g = gdwg::graph<int, E, Storage>{};
+		for (auto i = 0; i < node_count; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < edge_count; ++i) {
+			auto const from = node(engine);
+			auto const to = node(engine);
+			g.insert_edge(from, to, weight(engine));
+		}
+		return g;
+	}
+
+	// As above, with every edge unweighted.
+	template<typename Storage = gdwg::tree_storage>
+	auto random_graph(int node_count, int edge_count, unsigned seed)
+	   -> gdwg::graph<int, void, Storage> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+		auto g = gdwg::graph<int, void, Storage>{};
+		for (auto i = 0; i < node_count; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < edge_count; ++i) {
+			auto const from = node(engine);
+			auto const to = node(engine);
+			g.insert_edge(from, to);
+		}
+		return g;
+	}
+
+	// The graph with the same nodes as g and each of its edges, without the weight.
+	template<typename E, typename Storage>
+	auto unweighted(gdwg::graph<int, E, Storage> const& g) -> gdwg::graph<int, void, Storage> {
+		auto const nodes = g.nodes();
+		auto result = gdwg::graph<int, void, Storage>(nodes.begin(), nodes.end());
+		for (auto const& edge : g) {
+			result.insert_edge(edge.from, edge.to);
+		}
+		return result;
+	}
+} // namespace gdwg_test
+
+#endif // GDWG_TEST_RANDOM_GRAPH_HPP